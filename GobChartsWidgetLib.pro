@@ -21,6 +21,7 @@
 #  nature referring to or using this library include a reference to this site.
 
 QT       += xml
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets concurrent
 
 TARGET = gobchartswidget
 TEMPLATE = lib
@@ -34,7 +35,15 @@ SOURCES += \
     view/gobchartslineview.cpp \
     view/gobchartsfactory.cpp \
     view/gobchartsbarview.cpp \
+    view/gobchartsviewstrategy.cpp \
     utils/gobchartsvaliditems.cpp \
+    utils/gobchartslayout.cpp \
+    utils/gobchartsdatapyramid.cpp \
+    utils/gobchartsingestionqueue.cpp \
+    utils/gobchartsframeclock.cpp \
+    utils/gobchartshibernation.cpp \
+    utils/gobchartsstreambuffer.cpp \
+    utils/gobchartsstripitem.cpp \
     utils/gobchartsgrid.cpp \
     utils/gobchartsgraphitems.cpp \
     utils/gobchartscolours.cpp \
@@ -48,7 +57,15 @@ HEADERS += \
     view/gobchartslineview.h \
     view/gobchartsfactory.h \
     view/gobchartsbarview.h \
+    view/gobchartsviewstrategy.h \
     utils/gobchartsvaliditems.h \
+    utils/gobchartslayout.h \
+    utils/gobchartsdatapyramid.h \
+    utils/gobchartsingestionqueue.h \
+    utils/gobchartsframeclock.h \
+    utils/gobchartshibernation.h \
+    utils/gobchartsstreambuffer.h \
+    utils/gobchartsstripitem.h \
     utils/gobchartsnocopy.h \
     utils/gobchartsgrid.h \
     utils/gobchartsgraphitems.h \
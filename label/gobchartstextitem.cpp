@@ -25,12 +25,15 @@
 #include "utils/globalincludes.h"
 
 #include <QtCore/qmath.h>
-#include <QFontMetrics>
+#include <QFontMetricsF>
+#include <QHash>
 #include <QTextDocument>
 #include <QTextOption>
 #include <QDomDocument>
 #include <QMessageBox>
+#include <QPainter>
 #include <QTextCursor>
+#include <QTimer>
 
 /*--------------------------------------------------------------------------------*/
 
@@ -43,6 +46,12 @@ qreal PERCENTAGE_DEAD_SPACE   = 0.05;
   based on the total available width of the provided rectangle. */
 qreal PERCENTAGE_WIDTH_MARGIN = 0.05;
 
+/* The number of font fitting results remembered before the cache is cleared. */
+const int MAX_CACHED_FITS     = 256;
+
+/* Milliseconds over which setDetails() calls are coalesced into a single fit (one frame). */
+const int FIT_INTERVAL        = 16;
+
 
 /*------------------------ NONMEMBER UTILITY FUNCTIONS ---------------------------*/
 
@@ -80,6 +89,24 @@ bool LargerThanNew( const QRectF &memberRect, const QRectF &newTextRect )
             ( ( HigherThanNew( memberRect, newTextRect ) || HasSameHeight( memberRect, newTextRect ) ) && WiderThanNew ( memberRect, newTextRect ) ) );
 }
 
+/*--------------------------------------------------------------------------------*/
+
+/* Returns the rectangle "text" would occupy in a text item of width "textWidth" and the given font (this
+  mirrors QGraphicsTextItem::boundingRect() without having to lay out a text document).  The document's
+  margins sit inside "textWidth", i.e. the text itself wraps at the narrower width (as in paint()). */
+QRectF TextRect( const QString &text, const QFont &font, qreal textWidth, qreal documentMargin )
+{
+  QFontMetricsF metrics( font );
+  QRectF textRect = metrics.boundingRect( QRectF( 0, 0, qMax( qreal( 0.0 ), textWidth - 2 * documentMargin ), 0 ),
+                                          Qt::TextWordWrap,
+                                          text.isEmpty() ? QString( " " ) : text );
+
+  /* Words that are too long to wrap stick out, otherwise the item is exactly "textWidth" wide. */
+  return QRectF( 0, 0,
+                 qMax( textWidth, textRect.width() + 2 * documentMargin ),
+                 textRect.height() + 2 * documentMargin );
+}
+
 
 /*------------------------------- MEMBER FUNCTIONS -------------------------------*/
 
@@ -91,9 +118,16 @@ GobChartsTextItem::GobChartsTextItem( Qt::Orientation orientation, QString uniqu
   m_identity       ( uniqueID ),
   m_rectF          (),
   m_busyResizing   ( false ),
-  m_maxFontSize    ( 11 )
+  m_maxFontSize    ( 11 ),
+  m_fitTimer       ( NULLPOINTER ),
+  m_staticText     (),
+  m_staticTextDirty( true ),
+  m_editing        ( false )
 {
-  setTextInteractionFlags( Qt::TextEditable | Qt::TextEditorInteraction );
+  /* Display only until the user starts editing (but the view must still be able to give us focus). */
+  setTextInteractionFlags( Qt::NoTextInteraction );
+  setFlag( QGraphicsItem::ItemIsFocusable );
+  m_staticText.setPerformanceHint( QStaticText::AggressiveCaching );
 
   /* Only catering for a standard bottom to top orientation, i.e. if you tilt your
     head to the left, you should be able to read the text left to right without difficulty. */
@@ -108,6 +142,12 @@ GobChartsTextItem::GobChartsTextItem( Qt::Orientation orientation, QString uniqu
   /* Direct changes to the item's text will trigger a resize. */
   connect( m_textDocument, SIGNAL( contentsChanged() ), this, SLOT( resize() ) );
 
+  /* Batched changes trigger a single, deferred resize (cleanup handled by the object tree). */
+  m_fitTimer = new QTimer( this );
+  m_fitTimer->setSingleShot( true );
+  m_fitTimer->setInterval( FIT_INTERVAL );
+  connect( m_fitTimer, SIGNAL( timeout() ), this, SLOT( resize() ) );
+
   /* Set the alignment. */
   QTextOption textOption( m_alignment );
   m_textDocument->setDefaultTextOption( textOption );
@@ -176,6 +216,40 @@ void GobChartsTextItem::setPlainText( const QString &text )
 
 /*--------------------------------------------------------------------------------*/
 
+void GobChartsTextItem::setDetails( const QString &text, const QFont &font, const QColor &colour, Qt::Alignment alignment )
+{
+  /* Piggy-back on the resize guard to stop the individual changes from each triggering a fit. */
+  bool busyResizing = m_busyResizing;
+  m_busyResizing = true;
+
+  if( text != toPlainText() )
+  {
+    setPlainText( text );
+  }
+
+  if( alignment != m_alignment )
+  {
+    setAlignment( alignment );
+  }
+
+  /* Keep the fitted point size until the deferred fit determines the new one. */
+  QFont newFont( font );
+  newFont.setPointSize( this->font().pointSize() );
+  m_maxFontSize = font.pointSize();
+  QGraphicsTextItem::setFont( newFont );
+
+  setDefaultTextColor( colour );
+
+  m_busyResizing = busyResizing;
+
+  if( !m_fitTimer->isActive() )
+  {
+    m_fitTimer->start();
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+
 void GobChartsTextItem::setAlignment( Qt::Alignment alignment )
 {
   /* Formatting the text document triggers a resize through
@@ -196,56 +270,73 @@ Qt::Alignment GobChartsTextItem::alignment() const
 
 void GobChartsTextItem::resize()
 {
+  /* Whatever triggered the resize (text, font, alignment or size changes) invalidates the static text. */
+  m_staticTextDirty = true;
+
   /* Avoid triggering resizing recursively with the setFont() calls below. */
   if( !m_busyResizing && !m_rectF.isNull() )
   {
     m_busyResizing = true;
 
-    /* Creating a temporary item rather than updating this object's font the
-      whole time speeds things up a little bit (we delay setting the item's new
-      font until it's the desired size), but it is predominantly to make the
-      logic that follows easier to understand and the code more legible. */
-    QGraphicsTextItem tempItem( toPlainText() );
-    tempItem.setTextWidth( textWidth() );
-
-    QFont newFont( font() );
-    tempItem.setFont( newFont );
-
-    QRectF newRect( tempItem.boundingRect() );
-    bool   fontTooSmall( WiderThanNew ( m_rectF, newRect ) || HigherThanNew( m_rectF, newRect ) );
-
-    /* If the user set a specific point size, we don't want to exceed it. */
-    if( fontTooSmall && ( newFont.pointSize() < m_maxFontSize ) )
+    /* Fitting results only depend on the text, the font's face, the available space and the
+      user's maximum size, so identical requests (e.g. repeated resizes) cost a single lookup. */
+    static QHash< QString, int > fitCache;
+
+    QString text( toPlainText() );
+    QFont   newFont( font() );
+    QString key = QString( "%1|%2|%3|%4|%5x%6|%7|%8|%9" )
+                    .arg( newFont.family() )
+                    .arg( newFont.weight() )
+                    .arg( newFont.italic() )
+                    .arg( newFont.stretch() )
+                    .arg( m_rectF.width() )
+                    .arg( m_rectF.height() )
+                    .arg( static_cast< int >( m_orientation ) )
+                    .arg( m_maxFontSize )
+                    .arg( text );
+
+    int pointSize = fitCache.value( key, 0 );
+
+    if( pointSize == 0 )
     {
-      /* Increase the font size for as long as we stay within the acceptable boundaries. */
-      while( fontTooSmall && !LargerThanNew( m_rectF, newRect ) )
-      {
-        newFont.setPointSize( newFont.pointSize() + 1 );
-        tempItem.setFont( newFont );
-        newRect = tempItem.boundingRect();
-        fontTooSmall = ( WiderThanNew ( m_rectF, newRect ) || HigherThanNew( m_rectF, newRect ) );
-      }
+      /* Binary search for the largest point size (not exceeding the user's maximum) at which the
+        text still fits, with a minimum of one point. */
+      int low  = 1;
+      int high = qMax( 1, m_maxFontSize );
+      QFont testFont( newFont );
 
-      /* If the last iteration pushed the size beyond the acceptable
-        limits, decrease the font size with one. */
-      if( LargerThanNew( m_rectF, newRect ) && newFont.pointSize() > 1 )
+      while( low < high )
       {
-        newFont.setPointSize( newFont.pointSize() - 1 );
-        tempItem.setFont( newFont );
-        newRect = tempItem.boundingRect();
+        int middle = ( low + high + 1 ) / 2;
+        testFont.setPointSize( middle );
+
+        if( LargerThanNew( m_rectF, TextRect( text, testFont, textWidth(), document()->documentMargin() ) ) )
+        {
+          high = middle - 1;
+        }
+        else
+        {
+          low = middle;
+        }
       }
-    } else {
-      /* Decreases the font size until we're within the acceptable boundaries. */
-      while( ( LargerThanNew( m_rectF, newRect ) || newFont.pointSize() > m_maxFontSize ) &&
-               newFont.pointSize() > 1 )
+
+      pointSize = low;
+
+      if( fitCache.size() >= MAX_CACHED_FITS )
       {
-        newFont.setPointSize( newFont.pointSize() - 1 );
-        tempItem.setFont( newFont );
-        newRect = tempItem.boundingRect();
+        fitCache.clear();
       }
+
+      fitCache.insert( key, pointSize );
+    }
+
+    /* Only touch the font (and trigger a relayout) if it actually changes. */
+    if( newFont.pointSize() != pointSize )
+    {
+      newFont.setPointSize( pointSize );
+      setFont( newFont );
     }
 
-    setFont( newFont );
     m_busyResizing = false;
   }
 }
@@ -254,11 +345,67 @@ void GobChartsTextItem::resize()
 
 void GobChartsTextItem::receiveKeyEvent( QKeyEvent *event )
 {
+  setEditing( true );
   keyPressEvent( event );
 }
 
 /*--------------------------------------------------------------------------------*/
 
+void GobChartsTextItem::endForwardedEditing()
+{
+  if( !hasFocus() )
+  {
+    setEditing( false );
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsTextItem::paint( QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget )
+{
+  if( m_editing )
+  {
+    QGraphicsTextItem::paint( painter, option, widget );
+    return;
+  }
+
+  qreal margin = document()->documentMargin();
+
+  if( m_staticTextDirty )
+  {
+    QTextOption textOption( m_alignment );
+    textOption.setWrapMode( QTextOption::WordWrap );
+
+    m_staticText.setText( toPlainText() );
+    m_staticText.setTextFormat( Qt::PlainText );
+    m_staticText.setTextOption( textOption );
+    m_staticText.setTextWidth( qMax( qreal( 0.0 ), textWidth() - 2 * margin ) );
+    m_staticText.prepare( QTransform(), font() );
+    m_staticTextDirty = false;
+  }
+
+  /* The item's rotation (Y label) is already part of the painter's transform. */
+  painter->setFont( font() );
+  painter->setPen( defaultTextColor() );
+  painter->drawStaticText( QPointF( margin, margin ), m_staticText );
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsTextItem::setEditing( bool editing )
+{
+  if( editing != m_editing )
+  {
+    m_editing = editing;
+    setTextInteractionFlags( editing ? ( Qt::TextEditable | Qt::TextEditorInteraction ) : Qt::NoTextInteraction );
+    setFlag( QGraphicsItem::ItemIsFocusable );    // cleared by Qt::NoTextInteraction
+    m_staticTextDirty = true;
+    update();
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+
 QString GobChartsTextItem::getStateXML() const
 {
   QDomDocument doc;
@@ -348,8 +495,26 @@ bool GobChartsTextItem::setStateXML( const QDomNode &node )
 
 void GobChartsTextItem::mousePressEvent( QGraphicsSceneMouseEvent *event )
 {
+  /* Must happen first, the text control ignores the press while the item is display only. */
+  setEditing( true );
   QGraphicsTextItem::mousePressEvent( event );
   emit identity( m_identity );
 }
 
 /*--------------------------------------------------------------------------------*/
+
+void GobChartsTextItem::focusInEvent( QFocusEvent *event )
+{
+  setEditing( true );
+  QGraphicsTextItem::focusInEvent( event );
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsTextItem::focusOutEvent( QFocusEvent *event )
+{
+  QGraphicsTextItem::focusOutEvent( event );
+  setEditing( false );
+}
+
+/*--------------------------------------------------------------------------------*/
@@ -25,15 +25,21 @@
 #define GOBCHARTSTEXTITEM_H
 
 #include <QGraphicsTextItem>
+#include <QStaticText>
 #include "utils/gobchartsnocopy.h"
 
 class QTextDocument;
 class QDomNode;
+class QTimer;
 
 /// A convenience text item class that can resize itself.
 
 /** GobChartsTextItem automatically resizes itself to fit into whichever space is
-    allocated to it and allows for the text alignment to be specified. */
+    allocated to it and allows for the text alignment to be specified.
+
+    Labels are displayed far more often than they are edited.  Unless the item is being edited
+    (i.e. it has been clicked or has keyboard focus), it is painted from a cached QStaticText
+    rather than through its editable text document. */
 
 class GobChartsTextItem : public QGraphicsTextItem,
                           public GobChartsNoCopy
@@ -57,9 +63,16 @@ public:
       \sa setAlignment() */
   Qt::Alignment alignment() const;
 
-  /*! Receives forwarded keyboard input events. */
+  /*! Receives forwarded keyboard input events.
+      \sa endForwardedEditing() */
   void receiveKeyEvent( QKeyEvent *event );
 
+  /*! Switches back to the static text display once keyboard input is no longer forwarded.  Forwarded input
+      never results in a focus out event, so the view must call this itself.  Does nothing while the item has
+      keyboard focus (losing it ends editing).
+      \sa receiveKeyEvent() */
+  void endForwardedEditing();
+
   /*! Returns the label's content and settings as an XML QString.
       Charts are saved to file as XML, this function takes all the label's settings, converts it to XML and returns
       the XML string.
@@ -75,6 +88,14 @@ public:
   /*! Re-implemented from QGraphicsTextItem.  See Qt API documentation for details. */
   void setPlainText( const QString &text );
 
+  /*! Sets the text, (maximum) font, colour and alignment in one go.  Unlike calling the individual
+      setters, this does not re-fit the text after every change: a single fit is scheduled for the next
+      frame instead, which means that a burst of updates (e.g. typing) results in one layout per frame. */
+  void setDetails( const QString &text, const QFont &font, const QColor &colour, Qt::Alignment alignment );
+
+  /*! Re-implemented from QGraphicsTextItem to paint from the cached static text when not editing. */
+  void paint( QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget );
+
 public slots:
   /*! Sets the dimensions within which the text item's bounding
       rectangle must fit.  The item will reposition itself to be
@@ -90,6 +111,12 @@ protected:
   /*! Re-implemented from QGraphicsTextItem.  See Qt API documentation for details. */
   void mousePressEvent( QGraphicsSceneMouseEvent *event );
 
+  /*! Re-implemented from QGraphicsTextItem to switch to the editable text document. */
+  void focusInEvent( QFocusEvent *event );
+
+  /*! Re-implemented from QGraphicsTextItem to switch back to the static text display. */
+  void focusOutEvent( QFocusEvent *event );
+
   /*! Re-implemented from QGraphicsTextItem to call resize() whenever the font is changed. */
   void setFont( const QFont &font );
 
@@ -97,6 +124,9 @@ private slots:
   void resize();
 
 private:
+  /* Switches between the editable text document and the static text display. */
+  void setEditing( bool editing );
+
   Qt::Orientation m_orientation;
   Qt::Alignment   m_alignment;
   QTextDocument  *m_textDocument;
@@ -104,6 +134,10 @@ private:
   QRectF          m_rectF;
   bool            m_busyResizing;
   int             m_maxFontSize;
+  QTimer         *m_fitTimer;
+  QStaticText     m_staticText;
+  bool            m_staticTextDirty;
+  bool            m_editing;
 };
 
 #endif // GOBCHARTSTEXTITEM_H
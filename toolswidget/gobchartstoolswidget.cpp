@@ -28,6 +28,7 @@
 #include <QColorDialog>
 #include <QDomDocument>
 #include <QMessageBox>
+#include <QTimer>
 
 /*-------------------------------- FRIEND CLASS ----------------------------------*/
 
@@ -73,6 +74,11 @@ public:
     m_labelDetailsReceived( false ) {}
 };
 
+/*--------------------------------------------------------------------------------*/
+
+/* Range adjustments are forwarded to the chart at most once per display frame (~60 Hz). */
+const int RANGE_UPDATE_INTERVAL = 16;   // milliseconds
+
 /*--------------------------------- PIMPL STRUCT ---------------------------------*/
 
 struct GobChartsToolsWidget::GobChartsToolsWidgetPrivate
@@ -89,6 +95,7 @@ struct GobChartsToolsWidget::GobChartsToolsWidgetPrivate
   qreal m_upperBound;
   bool  m_showTotalRange;
   bool  m_rangePreferenceSet;
+  QTimer m_rangeTimer;         // coalesces rapid range adjustments into one update per frame
 
   /* Grid. */
   Qt::PenStyle m_penStyle;
@@ -115,13 +122,17 @@ struct GobChartsToolsWidget::GobChartsToolsWidgetPrivate
     m_upperBound        ( 0.0 ),
     m_showTotalRange    ( true ),
     m_rangePreferenceSet( false ),
+    m_rangeTimer        (),
     m_penStyle          ( Qt::DotLine ),
     m_gridColour        (),
     m_gridColourSet     ( false ),
     m_verticalGrid      ( false ),
     m_horizontalGrid    ( false ),
     m_typeButtonMap     ()
-  {}
+  {
+    m_rangeTimer.setSingleShot( true );
+    m_rangeTimer.setInterval( RANGE_UPDATE_INTERVAL );
+  }
 };
 
 
@@ -153,8 +164,9 @@ GobChartsToolsWidget::GobChartsToolsWidget( QWidget *parent ) :
 
   /* Data range related. */
   connect( ui->chartRangeToolButton, SIGNAL( clicked() ), this, SLOT( chartRangePreferenceChanged() ) );
-  connect( ui->chartRangeLowerBoundarySpinBox, SIGNAL( valueChanged( double ) ), this, SLOT( chartRangePreferenceSelected() ) );
-  connect( ui->chartRangeUpperBoundarySpinBox, SIGNAL( valueChanged( double ) ), this, SLOT( chartRangePreferenceSelected() ) );
+  connect( ui->chartRangeLowerBoundarySpinBox, SIGNAL( valueChanged( double ) ), this, SLOT( chartRangePreferenceEdited() ) );
+  connect( ui->chartRangeUpperBoundarySpinBox, SIGNAL( valueChanged( double ) ), this, SLOT( chartRangePreferenceEdited() ) );
+  connect( &m_private->m_rangeTimer, SIGNAL( timeout() ), this, SLOT( chartRangePreferenceSelected() ) );
 
   /* Chart type related. */
   m_private->m_chartButtonGroup.setExclusive( true );
@@ -299,6 +311,18 @@ void GobChartsToolsWidget::chartRangePreferenceChanged()
 
 /*--------------------------------------------------------------------------------*/
 
+void GobChartsToolsWidget::chartRangePreferenceEdited()
+{
+  /* Throttle rather than debounce: while the user keeps adjusting the range, the
+    chart is still updated live, just never more than once per frame. */
+  if( !m_private->m_rangeTimer.isActive() )
+  {
+    m_private->m_rangeTimer.start();
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+
 void GobChartsToolsWidget::chartRangePreferenceSelected()
 {
   /* In the process of loading the chart from XML, this function was found to be
@@ -850,6 +874,7 @@ void GobChartsToolsWidget::clearAndReset()
 
   ui->chartRangeLowerBoundarySpinBox->setValue( 0.0 );
   ui->chartRangeUpperBoundarySpinBox->setValue( 0.0 );
+  m_private->m_rangeTimer.stop();
   ui->gridHorizontalSpinBox->setValue( 0 );
   ui->gridVerticalSpinBox->setValue( 0 );
 
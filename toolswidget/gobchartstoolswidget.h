@@ -138,6 +138,7 @@ private slots:
   void chartTypeChanged( QAbstractButton *button );
   void chartColourPreferenceChanged();
   void chartRangePreferenceChanged();
+  void chartRangePreferenceEdited();
   void chartRangePreferenceSelected();
   void gridLinePreferenceChanged( QAbstractButton *button );
   void gridLineNumbersChanged();
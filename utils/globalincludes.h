@@ -24,6 +24,8 @@
 #ifndef GLOBAL_INCLUDES_H
 #define GLOBAL_INCLUDES_H
 
+#include <QtCore/qglobal.h>
+
 /*--------------------------------------------------------------------------------*/
 
 /*! Available chart types */
@@ -36,6 +38,81 @@ enum GobChartsLabel { HEADER, XLABEL, YLABEL, NONE };
 
 /*--------------------------------------------------------------------------------*/
 
+/*! Streaming (LINE) chart rendering modes.
+    - STREAM_ITEMS - every sample is a graphics item, the items are shifted as the window slides.
+    - STREAM_STRIP - the plot is rasterised into a pixmap which is scrolled as the window slides. */
+enum GobChartsStreamMode { STREAM_ITEMS, STREAM_STRIP };
+
+/*--------------------------------------------------------------------------------*/
+
+/*! Chart rendering backends.
+    - SCENE_BACKEND  - every chart item is a QGraphicsItem in the view's QGraphicsScene (the default).
+    - DIRECT_BACKEND - chart items are painted straight onto the viewport from the calculated geometry. */
+enum GobChartsBackend { SCENE_BACKEND, DIRECT_BACKEND };
+
+/*--------------------------------------------------------------------------------*/
+
+/*! Rendering quality tiers.
+    - FULL_QUALITY    - the view's normal render hints, gradients and graphics effects (drop shadows).
+    - REDUCED_QUALITY - gradients only, no antialiasing and no effects.
+    - DRAFT_QUALITY   - flat colours only. */
+enum GobChartsQuality { FULL_QUALITY, REDUCED_QUALITY, DRAFT_QUALITY };
+
+/*--------------------------------------------------------------------------------*/
+
+/*! Default settings, shared by GobChartsView and GobChartsWidget. */
+const int    DEFAULT_INGESTION_RATE     = 30;               // frames per second
+const int    DEFAULT_TIME_SLICE         = 8;                // milliseconds spent creating items per event loop iteration
+const int    DEFAULT_RESTORE_DELAY      = 250;              // milliseconds without interaction before full quality is restored
+const qint64 DEFAULT_SPECULATIVE_BUDGET = 8 * 1024 * 1024;  // bytes
+const qreal  DEFAULT_MIN_BAR_WIDTH      = 20.0;             // scrolling mode
+
+/*--------------------------------------------------------------------------------*/
+
+/*! Render scheduler statistics (all times in milliseconds). */
+struct GobChartsRenderStats
+{
+  qreal frameRate;          // frames actually rendered per second, measured over the last full second
+  qreal lastRenderTime;
+  qreal averageRenderTime;
+  int   renderedFrames;
+  int   droppedFrames;      // frame slots skipped because a render overran its frame budget
+  int   mergedRequests;     // redraw requests absorbed by an already scheduled frame
+  int   truncatedFrames;    // frames that ran out of budget and left the remaining items to later time slices
+
+  GobChartsRenderStats() :
+    frameRate        ( 0.0 ),
+    lastRenderTime   ( 0.0 ),
+    averageRenderTime( 0.0 ),
+    renderedFrames   ( 0 ),
+    droppedFrames    ( 0 ),
+    mergedRequests   ( 0 ),
+    truncatedFrames  ( 0 )
+  {}
+};
+
+/*--------------------------------------------------------------------------------*/
+
+/*! Chart hibernation statistics (memory figures are estimates, in bytes). */
+struct GobChartsHibernationStats
+{
+  int    hibernations;      // number of times the chart released its scene memory
+  int    wakeUps;           // number of times a hibernating chart was shown (and rebuilt) again
+  qint64 lastReclaimed;     // memory released by the last hibernation
+  qint64 totalReclaimed;
+  bool   hibernating;
+
+  GobChartsHibernationStats() :
+    hibernations  ( 0 ),
+    wakeUps       ( 0 ),
+    lastReclaimed ( 0 ),
+    totalReclaimed( 0 ),
+    hibernating   ( false )
+  {}
+};
+
+/*--------------------------------------------------------------------------------*/
+
 /*! Easier to search for than plain '0' and removes type safe problems of NULL macro. */
 const int NULLPOINTER = 0;
 
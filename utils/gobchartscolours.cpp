@@ -66,6 +66,20 @@ namespace GobChartsColours
     colourIndex = -1;
   }
 
+/*--------------------------------------------------------------------------------*/
+
+  QColor colourAt( int position )
+  {
+    return QColor( colourList.at( qAbs( position ) % colourList.size() ) );
+  }
+
+/*--------------------------------------------------------------------------------*/
+
+  int colourCount()
+  {
+    return colourList.size();
+  }
+
 /*--------------------------------------------------------------------------------*/
 
 }
@@ -35,6 +35,14 @@ namespace GobChartsColours
 
   /*! Resets the colour index to the beginning of the list. */
   void resetColourIndex();
+
+  /*! Returns the colour at "position" in the list (wrapping around at the end).  This yields the
+      same colour that the position'th call to getNextColour() after a reset would have, without
+      having to step through the list for every item that is skipped. */
+  QColor colourAt( int position );
+
+  /*! Returns the number of colours in the list (i.e. the length of the colour sequence). */
+  int colourCount();
 }
 
 #endif // GOBCHARTSCOLOURS_H
@@ -0,0 +1,158 @@
+/* Copyright (C) 2012 by William Hallatt.
+ *
+ * This file forms part of the "GobChartsWidget" library.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have downloaded a copy of the GNU General Public License
+ * (GNUGPL.txt) and GNU Lesser General Public License (GNULGPL.txt)
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * The official website for this project is www.goblincoding.com and,
+ * although not compulsory, it would be appreciated if all works of whatever
+ * nature referring to or using this library include a reference to this site.
+ */
+#include "gobchartsdatapyramid.h"
+
+#include <QtGlobal>
+
+/*--------------------------------------------------------------------------------*/
+
+GobChartsDataPyramid::GobChartsDataPyramid() :
+  m_levels()
+{
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsDataPyramid::build( const QVector< qreal > &values, const QList< int > &visiblePositions )
+{
+  m_levels.clear();
+
+  if( values.isEmpty() )
+  {
+    return;
+  }
+
+  QVector< GobChartsPyramidBucket > level( values.size() );
+
+  for( int i = 0; i < values.size(); i++ )
+  {
+    GobChartsPyramidBucket &bucket = level[ i ];
+    bucket.min   = 0.0;
+    bucket.max   = 0.0;
+    bucket.sum   = 0.0;
+    bucket.count = 0;
+    bucket.first = i;
+    bucket.last  = i;
+  }
+
+  foreach( int position, visiblePositions )
+  {
+    GobChartsPyramidBucket &bucket = level[ position ];
+    bucket.min   = values.at( position );
+    bucket.max   = values.at( position );
+    bucket.sum   = values.at( position );
+    bucket.count = 1;
+  }
+
+  m_levels.append( level );
+
+  while( m_levels.last().size() > 1 )
+  {
+    const QVector< GobChartsPyramidBucket > &below = m_levels.last();
+    QVector< GobChartsPyramidBucket > above( ( below.size() + 1 )/2 );
+
+    for( int i = 0; i < above.size(); i++ )
+    {
+      const GobChartsPyramidBucket &left = below.at( 2*i );
+      GobChartsPyramidBucket &merged = above[ i ];
+      merged = left;
+
+      if( 2*i + 1 < below.size() )
+      {
+        const GobChartsPyramidBucket &right = below.at( 2*i + 1 );
+
+        /* Empty buckets have no meaningful minimum or maximum. */
+        if( merged.count == 0 )
+        {
+          merged.min = right.min;
+          merged.max = right.max;
+        }
+        else if( right.count > 0 )
+        {
+          merged.min = qMin( merged.min, right.min );
+          merged.max = qMax( merged.max, right.max );
+        }
+
+        merged.sum   += right.sum;
+        merged.count += right.count;
+        merged.last   = right.last;
+      }
+    }
+
+    m_levels.append( above );
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsDataPyramid::clear()
+{
+  m_levels.clear();
+}
+
+/*--------------------------------------------------------------------------------*/
+
+int GobChartsDataPyramid::size() const
+{
+  return m_levels.isEmpty() ? 0 : m_levels.first().size();
+}
+
+/*--------------------------------------------------------------------------------*/
+
+int GobChartsDataPyramid::levels() const
+{
+  return m_levels.size();
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsDataPyramid::query( int first, int last, int maxBuckets, QVector< GobChartsPyramidBucket > &buckets ) const
+{
+  buckets.clear();
+
+  first = qMax( first, 0 );
+  last  = qMin( last, size() - 1 );
+
+  if( first > last )
+  {
+    return;
+  }
+
+  /* The range touches at most ( last >> k ) - ( first >> k ) + 1 buckets on level k. */
+  int level( 0 );
+
+  while( level < levels() - 1 && ( last >> level ) - ( first >> level ) + 1 > qMax( maxBuckets, 1 ) )
+  {
+    level++;
+  }
+
+  const QVector< GobChartsPyramidBucket > &source = m_levels.at( level );
+  buckets.reserve( ( last >> level ) - ( first >> level ) + 1 );
+
+  for( int i = first >> level; i <= last >> level; i++ )
+  {
+    buckets.append( source.at( i ) );
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
@@ -0,0 +1,76 @@
+/* Copyright (C) 2012 by William Hallatt.
+ *
+ * This file forms part of the "GobChartsWidget" library.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have downloaded a copy of the GNU General Public License
+ * (GNUGPL.txt) and GNU Lesser General Public License (GNULGPL.txt)
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * The official website for this project is www.goblincoding.com and,
+ * although not compulsory, it would be appreciated if all works of whatever
+ * nature referring to or using this library include a reference to this site.
+ */
+#ifndef GOBCHARTSDATAPYRAMID_H
+#define GOBCHARTSDATAPYRAMID_H
+
+#include <QList>
+#include <QVector>
+
+/*! Aggregate of a run of consecutive data positions. */
+struct GobChartsPyramidBucket
+{
+  qreal min;
+  qreal max;
+  qreal sum;
+  int   count;    // number of visible positions aggregated, 0 if none
+  int   first;    // first position covered
+  int   last;     // last position covered
+};
+
+/// Multi-resolution (min/max/sum) summary of the chart data.
+
+/** Level 0 of the pyramid holds one bucket per data position, every subsequent level halves the
+    resolution by merging pairs of buckets from the level below (i.e. a bucket on level "k" covers
+    2^k positions).  The pyramid is built in O(n) and takes up roughly twice the memory of level 0, in
+    return any range of positions can be summarised into at most a given number of buckets in time
+    proportional to that number, regardless of the size of the range. \n
+
+    Positions that are not visible (see GobChartsDataSnapshot::visiblePositions) are not aggregated.
+    The pyramid is implicitly shared and cheap to copy. */
+class GobChartsDataPyramid
+{
+public:
+  //! Constructor.
+  GobChartsDataPyramid();
+
+  /*! (Re)builds the pyramid from "values", aggregating only the positions in "visiblePositions" (ascending). */
+  void build( const QVector< qreal > &values, const QList< int > &visiblePositions );
+
+  /*! Removes all levels. */
+  void clear();
+
+  /*! Returns the number of positions summarised by the pyramid. */
+  int size() const;
+
+  /*! Returns the number of levels (0 if the pyramid is empty). */
+  int levels() const;
+
+  /*! Replaces the contents of "buckets" with the buckets of the finest level that covers positions "first"
+      to "last" with no more than "maxBuckets" buckets (the first and last buckets may extend beyond the range). */
+  void query( int first, int last, int maxBuckets, QVector< GobChartsPyramidBucket > &buckets ) const;
+
+private:
+  QVector< QVector< GobChartsPyramidBucket > > m_levels;
+};
+
+#endif // GOBCHARTSDATAPYRAMID_H
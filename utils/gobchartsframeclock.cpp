@@ -0,0 +1,167 @@
+/* Copyright (C) 2012 by William Hallatt.
+ *
+ * This file forms part of the "GobChartsWidget" library.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have downloaded a copy of the GNU General Public License
+ * (GNUGPL.txt) and GNU Lesser General Public License (GNULGPL.txt)
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * The official website for this project is www.goblincoding.com and,
+ * although not compulsory, it would be appreciated if all works of whatever
+ * nature referring to or using this library include a reference to this site.
+ */
+
+#include "gobchartsframeclock.h"
+
+#include <QtCore/qmath.h>
+
+/*--------------------------------------------------------------------------------*/
+
+const int FRAME_RATE_WINDOW = 1000;  // milliseconds over which the actual frame rate is measured
+
+/*--------------------------------------------------------------------------------*/
+
+GobChartsFrameClock::GobChartsFrameClock() :
+  m_clock          (),
+  m_stats          (),
+  m_totalRenderTime( 0.0 ),
+  m_frameStart     ( 0 ),
+  m_nextFrameTime  ( 0 ),
+  m_windowStart    ( 0 ),
+  m_windowFrames   ( 0 ),
+  m_frameInterval  ( 0 ),
+  m_frameBudget    ( 0 ),
+  m_frameDeadline  ( 0 )
+{
+  m_clock.start();
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsFrameClock::setMaximumFrameRate( int framesPerSecond )
+{
+  m_frameInterval = ( framesPerSecond > 0 ) ? qMax( 1, 1000/framesPerSecond ) : 0;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+bool GobChartsFrameClock::isCapped() const
+{
+  return m_frameInterval > 0;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsFrameClock::setFrameBudget( int milliseconds )
+{
+  m_frameBudget = qMax( 0, milliseconds );
+}
+
+/*--------------------------------------------------------------------------------*/
+
+int GobChartsFrameClock::timeToNextFrame() const
+{
+  return static_cast< int >( qMax( qint64( 0 ), m_nextFrameTime - m_clock.elapsed() ) );
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsFrameClock::beginFrame()
+{
+  m_frameStart = m_clock.nsecsElapsed();
+
+  qint64 start    = m_frameStart / 1000000;
+  m_frameDeadline = isCapped() ? start + ( ( m_frameBudget > 0 ) ? m_frameBudget : m_frameInterval ) : 0;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+int GobChartsFrameClock::endFrame()
+{
+  qreal  renderTime = ( m_clock.nsecsElapsed() - m_frameStart ) / 1000000.0;
+  qint64 start      = m_frameStart / 1000000;
+  qint64 now        = m_clock.elapsed();
+  m_frameDeadline   = 0;
+
+  m_stats.renderedFrames++;
+  m_stats.lastRenderTime     = renderTime;
+  m_totalRenderTime         += renderTime;
+  m_stats.averageRenderTime  = m_totalRenderTime / m_stats.renderedFrames;
+
+  /* Actual frame rate. */
+  m_windowFrames++;
+  qint64 windowElapsed = now - m_windowStart;
+
+  if( windowElapsed >= FRAME_RATE_WINDOW )
+  {
+    m_stats.frameRate = m_windowFrames * 1000.0 / windowElapsed;
+    m_windowStart  = now;
+    m_windowFrames = 0;
+  }
+
+  /* Frame budget. */
+  int skipped = 0;
+
+  if( isCapped() )
+  {
+    if( renderTime > ( ( m_frameBudget > 0 ) ? m_frameBudget : m_frameInterval ) )
+    {
+      skipped = qMax( 1, qCeil( renderTime / m_frameInterval ) - 1 );
+      m_stats.droppedFrames += skipped;
+    }
+
+    m_nextFrameTime = start + ( 1 + skipped ) * m_frameInterval;
+  }
+
+  return skipped;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+bool GobChartsFrameClock::budgetExceeded() const
+{
+  return ( m_frameDeadline > 0 ) && ( m_clock.elapsed() > m_frameDeadline );
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsFrameClock::countMergedRequest()
+{
+  m_stats.mergedRequests++;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsFrameClock::countTruncatedFrame()
+{
+  m_stats.truncatedFrames++;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+const GobChartsRenderStats &GobChartsFrameClock::stats() const
+{
+  return m_stats;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsFrameClock::resetStats()
+{
+  m_stats           = GobChartsRenderStats();
+  m_totalRenderTime = 0.0;
+  m_windowStart     = m_clock.elapsed();
+  m_windowFrames    = 0;
+}
+
+/*--------------------------------------------------------------------------------*/
@@ -0,0 +1,92 @@
+/* Copyright (C) 2012 by William Hallatt.
+ *
+ * This file forms part of the "GobChartsWidget" library.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have downloaded a copy of the GNU General Public License
+ * (GNUGPL.txt) and GNU Lesser General Public License (GNULGPL.txt)
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * The official website for this project is www.goblincoding.com and,
+ * although not compulsory, it would be appreciated if all works of whatever
+ * nature referring to or using this library include a reference to this site.
+ */
+
+#ifndef GOBCHARTSFRAMECLOCK_H
+#define GOBCHARTSFRAMECLOCK_H
+
+#include <QElapsedTimer>
+#include "utils/globalincludes.h"
+#include "utils/gobchartsnocopy.h"
+
+/// Time base, frame window and statistics of a chart's render scheduler.
+
+/** GobChartsFrameClock keeps track of when the next frame may be rendered (given a maximum frame rate),
+    of the deadline of the frame currently being rendered (given a frame budget) and of the render
+    statistics.  It does not schedule anything itself: the chart asks it how long to wait before
+    rendering and brackets every frame with beginFrame() and endFrame().  All times are in milliseconds. */
+class GobChartsFrameClock : public GobChartsNoCopy
+{
+public:
+  //! Constructor.
+  GobChartsFrameClock();
+
+  /*! Caps the frame rate at "framesPerSecond", 0 removes the cap. */
+  void setMaximumFrameRate( int framesPerSecond );
+
+  /*! Returns "true" if the frame rate is capped. */
+  bool isCapped() const;
+
+  /*! Sets the time a frame may take before its remaining work is deferred, 0 makes the frame interval the budget. */
+  void setFrameBudget( int milliseconds );
+
+  /*! Returns the time until the next frame may be rendered (0 if it may be rendered right away). */
+  int timeToNextFrame() const;
+
+  /*! Marks the start of a frame and sets its deadline (capped frame rates only).
+      \sa endFrame() */
+  void beginFrame();
+
+  /*! Marks the end of the frame started with beginFrame(), updates the statistics and determines when the next
+      frame may be rendered.  Returns the number of frame slots skipped because the frame overran its budget.
+      \sa beginFrame() */
+  int endFrame();
+
+  /*! Returns "true" if the frame currently being rendered has used up its budget. */
+  bool budgetExceeded() const;
+
+  /*! Counts a redraw request absorbed by an already scheduled (or deferred) frame. */
+  void countMergedRequest();
+
+  /*! Counts a frame that ran out of budget and left its remaining work to later time slices. */
+  void countTruncatedFrame();
+
+  /*! Returns the render statistics. */
+  const GobChartsRenderStats &stats() const;
+
+  /*! Resets the render statistics. */
+  void resetStats();
+
+private:
+  QElapsedTimer        m_clock;           // monotonic time base
+  GobChartsRenderStats m_stats;
+  qreal                m_totalRenderTime;
+  qint64               m_frameStart;      // time (m_clock, nanoseconds) at which the frame being rendered started
+  qint64               m_nextFrameTime;   // earliest time (m_clock) at which the next frame may be rendered
+  qint64               m_windowStart;     // start of the window over which the actual frame rate is measured
+  int                  m_windowFrames;
+  int                  m_frameInterval;   // 0 if the frame rate isn't capped
+  int                  m_frameBudget;     // 0 if the frame interval is the budget
+  qint64               m_frameDeadline;   // time (m_clock) at which the frame being rendered runs out of budget, 0 if none
+};
+
+#endif // GOBCHARTSFRAMECLOCK_H
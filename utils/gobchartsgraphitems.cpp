@@ -24,6 +24,7 @@
 #include "gobchartsgraphitems.h"
 #include "utils/globalincludes.h"
 
+#include <QGraphicsEffect>
 #include <QGraphicsItem>
 #include <QGraphicsScene>
 #include <QModelIndex>
@@ -38,6 +39,8 @@ GobChartsGraphItems::GobChartsGraphItems( QObject *parent ) :
   QObject        ( parent ),
   m_graphItemMap (),
   m_legendItemMap(),
+  m_rowItemMap   (),
+  m_selectedRow  ( -1 ),
   m_loggingOn    ( false )
 {
 }
@@ -93,33 +96,46 @@ void GobChartsGraphItems::removeItemsFromScene( QGraphicsScene *scene )
 
 void GobChartsGraphItems::setSelected( int categoryRow )
 {
-  QMap<QModelIndex, QGraphicsItem*>::iterator it = m_graphItemMap.begin();
+  /* Only the selected item is ever less than opaque, so there is no need to visit all the others. */
+  bool toggleOff = ( categoryRow == m_selectedRow );
+  clearSelection();
 
-  while( it != m_graphItemMap.end() )
+  if( !toggleOff && m_rowItemMap.contains( categoryRow ) )
   {
-    if( ( it.key().row() == categoryRow ) && ( it.value()->opacity() != OPACITY ) )
-    {
-      it.value()->setOpacity( OPACITY );
-    }
-    else
-    {
-      it.value()->setOpacity( 1.0 );
-    }
-
-    it++;
+    m_rowItemMap.value( categoryRow )->setOpacity( OPACITY );
+    m_selectedRow = categoryRow;
   }
 }
 
 /*--------------------------------------------------------------------------------*/
 
+int GobChartsGraphItems::selectedRow() const
+{
+  return m_selectedRow;
+}
+
+/*--------------------------------------------------------------------------------*/
+
 void GobChartsGraphItems::clearSelection()
 {
-  QMap<QModelIndex, QGraphicsItem*>::iterator it = m_graphItemMap.begin();
+  if( m_rowItemMap.contains( m_selectedRow ) )
+  {
+    m_rowItemMap.value( m_selectedRow )->setOpacity( 1.0 );
+  }
+
+  m_selectedRow = -1;
+}
+
+/*--------------------------------------------------------------------------------*/
 
-  while( it != m_graphItemMap.end() )
+void GobChartsGraphItems::setEffectsEnabled( bool enabled )
+{
+  foreach( QGraphicsItem *item, m_graphItemMap )
   {
-    it.value()->setOpacity( 1.0 );
-    it++;
+    if( item && item->graphicsEffect() )
+    {
+      item->graphicsEffect()->setEnabled( enabled );
+    }
   }
 }
 
@@ -131,6 +147,7 @@ void GobChartsGraphItems::addItem( const QModelIndex &valueIndex, QGraphicsItem
   {
     m_graphItemMap.insert( valueIndex, item );
     m_legendItemMap.insert( legendText, item );
+    m_rowItemMap.insert( valueIndex.row(), item );
   }
 }
 
@@ -149,6 +166,8 @@ void GobChartsGraphItems::deleteItems()
 
   m_graphItemMap.clear();
   m_legendItemMap.clear();
+  m_rowItemMap.clear();
+  m_selectedRow = -1;
 }
 
 /*--------------------------------------------------------------------------------*/
@@ -25,6 +25,7 @@
 #define GOBCHARTSGRAPHITEMS_H
 
 #include <QObject>
+#include <QHash>
 #include <QMap>
 #include <QModelIndex>
 #include "utils/gobchartsnocopy.h"
@@ -62,14 +63,22 @@ public:
   /*! Manipulates the QGraphicsItem corresponding to the given category row
       (if mapped and found) by changing it's opacity.  When selected the first time,
       this function lessens the item's opacity (makes it more transparent), otherwise
-      it resets the item to being completely opaque.
-      \sa clearSelection() */
+      it resets the item to being completely opaque.  Only the previously selected item and the
+      item corresponding to "categoryRow" are touched.
+      \sa clearSelection(), selectedRow() */
   void setSelected( int categoryRow );
 
+  /*! Returns the category row of the currently highlighted item, or -1 if there is none. */
+  int selectedRow() const;
+
   /*! Clears the current selection.  This function will return all the graphic items
       to their original opacity. */
   void clearSelection();
 
+  /*! Enables or disables the graphics effects (e.g. drop shadows) of all the mapped items.  Disabled
+      effects are retained and can be re-enabled without having to re-create the items. */
+  void setEffectsEnabled( bool enabled );
+
   /*! Adds a QModelIndex/QGraphicsItem pair to the map.  This function furthermore ensures that
       the added item can be retrieved based on its corresponding legend text.
       \sa deleteItems() */
@@ -107,6 +116,8 @@ signals:
 private:
   QMap< QModelIndex, QGraphicsItem* > m_graphItemMap;
   QMap< QString,     QGraphicsItem* > m_legendItemMap;
+  QHash< int,        QGraphicsItem* > m_rowItemMap;
+  int  m_selectedRow;
   bool m_loggingOn;
 };
 
@@ -24,27 +24,94 @@
 #include "gobchartsgrid.h"
 #include "utils/globalincludes.h"
 
-#include <QGraphicsLineItem>
 #include <QGraphicsScene>
+#include <QPainter>
+#include <QPainterPath>
 
 /*--------------------------------------------------------------------------------*/
 
 /* Distance line intercepts extend past axis. */
 const int EXTEND = 5;
 
+/* Grid lines are never drawn closer together than this (in pixels of a standard 96 dpi display). */
+const qreal MIN_LINE_SPACING = 4.0;
+
+/*--------------------------------------------------------------------------------*/
+
+/* Draws the axes and grid line paths with their respective pens.  The item has no shape
+  so that it never interferes with hit testing or item selection. */
+class GobChartsGridItem : public QGraphicsItem
+{
+public:
+  GobChartsGridItem() :
+    QGraphicsItem(),
+    m_axesPath   (),
+    m_gridPath   (),
+    m_axesPen    (),
+    m_gridPen    (),
+    m_boundingRect()
+  {
+    setAcceptedMouseButtons( 0 );
+  }
+
+  void setPaths( const QPainterPath &axes, const QPen &axesPen, const QPainterPath &grid, const QPen &gridPen )
+  {
+    prepareGeometryChange();
+    m_axesPath = axes;
+    m_gridPath = grid;
+    m_axesPen  = axesPen;
+    m_gridPen  = gridPen;
+
+    qreal margin = qMax( axesPen.widthF(), gridPen.widthF() );
+    m_boundingRect = axes.boundingRect().united( grid.boundingRect() ).adjusted( -margin, -margin, margin, margin );
+    update();
+  }
+
+  QRectF boundingRect() const
+  {
+    return m_boundingRect;
+  }
+
+  QPainterPath shape() const
+  {
+    return QPainterPath();
+  }
+
+  void paint( QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget )
+  {
+    Q_UNUSED( option );
+    Q_UNUSED( widget );
+
+    painter->setPen( m_gridPen );
+    painter->drawPath( m_gridPath );
+
+    painter->setPen( m_axesPen );
+    painter->drawPath( m_axesPath );
+  }
+
+private:
+  QPainterPath m_axesPath;
+  QPainterPath m_gridPath;
+  QPen         m_axesPen;
+  QPen         m_gridPen;
+  QRectF       m_boundingRect;
+};
+
 /*--------------------------------------------------------------------------------*/
 
 GobChartsGrid::GobChartsGrid( QObject *parent ) :
   QObject             ( parent ),
-  m_gridLines         (),
+  m_gridItem          ( new GobChartsGridItem ),
   m_rectF             (),
   m_gridPen           ( QPen( QBrush( Qt::black ), 1, Qt::DotLine ) ),
   m_axesPen           ( QPen( QBrush( Qt::black ), 2 ) ),
   m_nrHorizontalLines ( 0 ),
   m_nrVerticalLines   ( 0 ),
+  m_deviceScale       ( 1.0 ),
   m_showHorizontalGrid( false ),
   m_showVerticalGrid  ( false ),
-  m_loggingOn         ( false )
+  m_loggingOn         ( false ),
+  m_dirty             ( true )
 {
 }
 
@@ -52,16 +119,12 @@ GobChartsGrid::GobChartsGrid( QObject *parent ) :
 
 GobChartsGrid::~GobChartsGrid() 
 {
-  for( int i = 0; i < m_gridLines.size(); i++ )
+  if( m_gridItem->scene() )
   {
-    QGraphicsLineItem *line = m_gridLines.at( i );
-
-    if( line )
-    {
-      delete line;
-      line = NULLPOINTER;
-    }
+    m_gridItem->scene()->removeItem( m_gridItem );
   }
+
+  delete m_gridItem;
 }
 
 /*--------------------------------------------------------------------------------*/
@@ -70,9 +133,9 @@ void GobChartsGrid::addGridToScene( QGraphicsScene *scene )
 {
   if( scene )
   {
-    foreach( QGraphicsLineItem *line, m_gridLines )
+    if( m_gridItem->scene() != scene )
     {
-      if( line ) scene->addItem( line );
+      scene->addItem( m_gridItem );
     }
   }
   else
@@ -90,9 +153,9 @@ void GobChartsGrid::removeGridFromScene( QGraphicsScene *scene )
 {
   if( scene )
   {
-    foreach( QGraphicsLineItem *line, m_gridLines )
+    if( m_gridItem->scene() == scene )
     {
-      if( line ) scene->removeItem( line );
+      scene->removeItem( m_gridItem );
     }
   }
   else
@@ -106,72 +169,87 @@ void GobChartsGrid::removeGridFromScene( QGraphicsScene *scene )
 
 /*--------------------------------------------------------------------------------*/
 
-void GobChartsGrid::constructGrid()
+void GobChartsGrid::releaseGrid()
 {
-  /* Clear existing grid and axes lines. */
-  if( !m_gridLines.empty() )
-  {
-    for( int i = 0; i < m_gridLines.size(); i++ )
-    {
-      QGraphicsLineItem *line = m_gridLines.at( i );
+  m_gridItem->setPaths( QPainterPath(), m_axesPen, QPainterPath(), m_gridPen );
+  m_dirty = true;
+}
 
-      if( line )
-      {
-        delete line;
-        line = NULLPOINTER;
-      }
-    }
+/*--------------------------------------------------------------------------------*/
 
-    m_gridLines.clear();   // remove pointers
+void GobChartsGrid::constructGrid()
+{
+  if( !m_dirty )
+  {
+    return;
   }
 
-  /* Create x and y axes. */
-  QGraphicsLineItem *xAxis = new QGraphicsLineItem;
-  xAxis->setLine( m_rectF.left(), m_rectF.bottom(), m_rectF.right(), m_rectF.bottom() );
-  xAxis->setPen ( m_axesPen );
-  m_gridLines.append( xAxis );
+  m_dirty = false;
 
-  QGraphicsLineItem *yAxis = new QGraphicsLineItem;
-  yAxis->setLine( m_rectF.left(), m_rectF.top(), m_rectF.left(), m_rectF.bottom() );
-  yAxis->setPen ( m_axesPen );
-  m_gridLines.append( yAxis );
+  /* X and y axes. */
+  QPainterPath axes;
+  axes.moveTo( m_rectF.left(),  m_rectF.top() );
+  axes.lineTo( m_rectF.left(),  m_rectF.bottom() );
+  axes.lineTo( m_rectF.right(), m_rectF.bottom() );
 
-  /* Create vertical line items. */
-  if( m_nrVerticalLines > 0 )
+  QPainterPath grid;
+
+  /* Vertical grid lines and "x" intercepts. */
+  if( m_showVerticalGrid && m_nrVerticalLines > 0 )
   {
-    qreal spacing = ( m_rectF.width()/m_nrVerticalLines );
+    int   nrLines = cappedLineCount( m_nrVerticalLines, m_rectF.width() );
+    qreal spacing = ( m_rectF.width()/nrLines );
 
-    if( m_showVerticalGrid )              // vertical grid lines and "x" intercepts
+    for( int i = 1; i <= nrLines; i++ )
     {
-      for( int i = 1; i <= m_nrVerticalLines; i++ )
-      {
-        QGraphicsLineItem *xLine = new QGraphicsLineItem( m_rectF.left() + i * spacing,
-                                                          m_rectF.top(),
-                                                          m_rectF.left() + i * spacing,
-                                                          m_rectF.bottom() + EXTEND );
-        xLine->setPen( m_gridPen );
-        m_gridLines.append( xLine );
-      }
+      grid.moveTo( m_rectF.left() + i * spacing, m_rectF.top() );
+      grid.lineTo( m_rectF.left() + i * spacing, m_rectF.bottom() + EXTEND );
     }
   }
 
-  /* Create horizontal line items. */
-  if( m_nrHorizontalLines > 0 )
+  /* Horizontal grid lines and "y" intercepts. */
+  if( m_showHorizontalGrid && m_nrHorizontalLines > 0 )
   {
-    qreal spacing = ( m_rectF.height()/m_nrHorizontalLines );
+    int   nrLines = cappedLineCount( m_nrHorizontalLines, m_rectF.height() );
+    qreal spacing = ( m_rectF.height()/nrLines );
+
+    for( int i = 0; i <= nrLines; i++ )
+    {
+      grid.moveTo( m_rectF.left() - EXTEND, m_rectF.top() + i * spacing );
+      grid.lineTo( m_rectF.right(),         m_rectF.top() + i * spacing );
+    }
+  }
+
+  m_gridItem->setPaths( axes, m_axesPen, grid, m_gridPen );
+}
 
-    if( m_showHorizontalGrid )            // horizontal grid lines and "y" intercepts
+/*--------------------------------------------------------------------------------*/
+
+int GobChartsGrid::cappedLineCount( int requested, qreal length )
+{
+  int allowed = qMax( 1, static_cast< int >( length/( MIN_LINE_SPACING * m_deviceScale ) ) );
+
+  if( requested > allowed )
+  {
+    if( m_loggingOn )
     {
-      for( int i = 0; i <= m_nrHorizontalLines; i++ )
-      {
-        QGraphicsLineItem *yLine = new QGraphicsLineItem( m_rectF.left() - EXTEND,
-                                                          m_rectF.top() + i * spacing,
-                                                          m_rectF.right(),
-                                                          m_rectF.top() + i * spacing );
-        yLine->setPen( m_gridPen );
-        m_gridLines.append( yLine );
-      }
+      emit lastDebugLogMsg( tr( "GobChartsGrid::constructGrid# Reducing [%1] grid lines to [%2] to keep them apart." ).arg( requested ).arg( allowed ) );
     }
+
+    return allowed;
+  }
+
+  return requested;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsGrid::setDeviceScale( qreal scale )
+{
+  if( scale > 0.0 && !qFuzzyCompare( scale, m_deviceScale ) )
+  {
+    m_deviceScale = scale;
+    m_dirty = true;
   }
 }
 
@@ -179,7 +257,11 @@ void GobChartsGrid::constructGrid()
 
 void GobChartsGrid::setGridRectF( const QRectF &rect )
 {
-  m_rectF = rect;
+  if( rect != m_rectF )
+  {
+    m_rectF = rect;
+    m_dirty = true;
+  }
 }
 
 /*--------------------------------------------------------------------------------*/
@@ -191,10 +273,32 @@ qreal GobChartsGrid::gridWidth() const
 
 /*--------------------------------------------------------------------------------*/
 
+void GobChartsGrid::paintGrid( QPainter *painter ) const
+{
+  m_gridItem->paint( painter, NULLPOINTER, NULLPOINTER );
+}
+
+/*--------------------------------------------------------------------------------*/
+
+bool GobChartsGrid::isDirty() const
+{
+  return m_dirty;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsGrid::setCacheMode( QGraphicsItem::CacheMode mode )
+{
+  m_gridItem->setCacheMode( mode );
+}
+
+/*--------------------------------------------------------------------------------*/
+
 void GobChartsGrid::setHorizontalGridLines( bool set, int number )
 {
   m_showHorizontalGrid = set;
   m_nrHorizontalLines  = number;
+  m_dirty              = true;
 }
 
 /*--------------------------------------------------------------------------------*/
@@ -203,6 +307,7 @@ void GobChartsGrid::setVerticalGridLines( bool set, int number )
 {
   m_showVerticalGrid = set;
   m_nrVerticalLines  = number;
+  m_dirty            = true;
 }
 
 /*--------------------------------------------------------------------------------*/
@@ -210,6 +315,7 @@ void GobChartsGrid::setVerticalGridLines( bool set, int number )
 void GobChartsGrid::setGridColour( QColor colour )
 {
   m_gridPen.setColor( colour );
+  m_dirty = true;
 }
 
 /*--------------------------------------------------------------------------------*/
@@ -217,6 +323,7 @@ void GobChartsGrid::setGridColour( QColor colour )
 void GobChartsGrid::setGridLineStyle( Qt::PenStyle style )
 {
   m_gridPen.setStyle( style );
+  m_dirty = true;
 }
 
 /*--------------------------------------------------------------------------------*/
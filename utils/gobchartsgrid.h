@@ -24,19 +24,22 @@
 #ifndef GOBCHARTSGRID_H
 #define GOBCHARTSGRID_H
 
-#include <QList>
+#include <QGraphicsItem>
 #include <QPen>
 #include "utils/gobchartsnocopy.h"
 
-class QGraphicsLineItem;
 class QGraphicsScene;
+class QPainter;
+class GobChartsGridItem;
 
 /// Generates and manages grid and axes lines.
 
-/** GobChartsGrid maintains a list of all grid lines as well as the chart's x and y axes.  
-    Line lengths and positions are recalculated when constructGrid() is called, are
-    determined by the dimensions and restricted to the boundaries of the grid's rectangle. 
-    The class furthermore provides the functionality to add or remove the lines to a QGraphicsScene. */
+/** GobChartsGrid maintains the chart's x and y axes and grid lines as two painter paths (one per pen)
+    drawn by a single graphics item.  Line lengths and positions are recalculated when constructGrid() is
+    called (and only if the grid's rectangle, line numbers or pens changed since the last call), are
+    determined by the dimensions and restricted to the boundaries of the grid's rectangle.  Grid lines are
+    never drawn closer together than a few pixels, the number of lines is reduced automatically if need be.
+    The class furthermore provides the functionality to add or remove the grid to a QGraphicsScene. */
 class GobChartsGrid : public QObject,
                       public GobChartsNoCopy
 {
@@ -57,11 +60,15 @@ public:
       \sa addGridToScene() */
   void removeGridFromScene( QGraphicsScene *scene );
 
-  /*! Constructs grid and axes lines. Deletes all existing line items, recalculates the 
-      grid's dimensions and creates the new axes and grid lines according to the geometric
-      settings and custom grid specifications. */
+  /*! Constructs grid and axes lines. Recalculates the grid's dimensions and rebuilds the axes and
+      grid line paths according to the geometric settings and custom grid specifications.  Does nothing
+      if nothing changed since the last call.
+      \sa isDirty() */
   void constructGrid();
 
+  /*! Releases the memory taken up by the axes and grid line paths.  The next call to constructGrid() rebuilds them. */
+  void releaseGrid();
+
   /*! Sets the grid's spatial dimensions.  The grid will be confined to the 
       dimensions of the given rectangle. */
   void setGridRectF( const QRectF &rect );
@@ -84,6 +91,22 @@ public:
   /*! Returns the grid's width. */
   qreal gridWidth() const;
 
+  /*! Paints the axes and grid lines with "painter" (scene coordinates), this is used when the chart is
+      painted directly rather than via the scene. */
+  void paintGrid( QPainter *painter ) const;
+
+  /*! Returns "true" if the grid's dimensions or settings changed since the last call to constructGrid(). */
+  bool isDirty() const;
+
+  /*! Sets the number of scene units that make up one pixel of a standard (96 dpi) display at the view's current
+      transform (default 1.0).  The minimum distance between grid lines is scaled accordingly so that lines stay
+      visibly apart on high resolution screens and in scaled views. */
+  void setDeviceScale( qreal scale );
+
+  /*! Sets the cache mode of the grid item (default QGraphicsItem::NoCache).  Since the grid rarely
+      changes, caching it means that it is not re-rasterised when the chart items change. */
+  void setCacheMode( QGraphicsItem::CacheMode mode );
+
   /*! Turn debug logging "on" or "off" (default "off").
       \sa lastDebugLogMsg() */
   void setDebugLoggingOn( bool logging );
@@ -95,15 +118,21 @@ signals:
   void lastDebugLogMsg( QString );
 
 private:
-  QList< QGraphicsLineItem* > m_gridLines;
+  /* Returns "requested", reduced if need be so that lines are at least MIN_LINE_SPACING (scaled by
+    the device scale) apart over "length". */
+  int cappedLineCount( int requested, qreal length );
+
+  GobChartsGridItem *m_gridItem;
   QRectF m_rectF;
   QPen   m_gridPen;
   QPen   m_axesPen;
   int    m_nrHorizontalLines;
   int    m_nrVerticalLines;
+  qreal  m_deviceScale;
   bool   m_showHorizontalGrid;
   bool   m_showVerticalGrid;
   bool   m_loggingOn;
+  bool   m_dirty;
 };
 
 #endif // GOBCHARTSGRID_H
@@ -0,0 +1,127 @@
+/* Copyright (C) 2012 by William Hallatt.
+ *
+ * This file forms part of the "GobChartsWidget" library.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have downloaded a copy of the GNU General Public License
+ * (GNUGPL.txt) and GNU Lesser General Public License (GNULGPL.txt)
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * The official website for this project is www.goblincoding.com and,
+ * although not compulsory, it would be appreciated if all works of whatever
+ * nature referring to or using this library include a reference to this site.
+ */
+
+#include "gobchartshibernation.h"
+
+#include <QHash>
+#include <QList>
+
+/*--------------------------------------------------------------------------------*/
+
+namespace GobChartsHibernation
+{
+  namespace{
+    QList< GobChartsHibernatable* >          charts;           // least recently shown first
+    QHash< GobChartsHibernatable*, qint64 >  chartMemory;      // bytes
+    qint64                                   totalMemory( 0 ); // sum of chartMemory
+    qint64                                   budget( 0 );      // bytes, 0 if there is no budget
+  }
+
+/*--------------------------------------------------------------------------------*/
+
+  void registerChart( GobChartsHibernatable *chart )
+  {
+    charts.append( chart );
+    chartMemory.insert( chart, 0 );
+  }
+
+/*--------------------------------------------------------------------------------*/
+
+  void unregisterChart( GobChartsHibernatable *chart )
+  {
+    charts.removeAll( chart );
+    totalMemory -= chartMemory.take( chart );
+  }
+
+/*--------------------------------------------------------------------------------*/
+
+  void chartShown( GobChartsHibernatable *chart )
+  {
+    charts.removeAll( chart );
+    charts.append( chart );
+  }
+
+/*--------------------------------------------------------------------------------*/
+
+  void setSceneMemory( GobChartsHibernatable *chart, qint64 bytes )
+  {
+    if( !chartMemory.contains( chart ) )
+    {
+      return;   // not (or no longer) registered
+    }
+
+    totalMemory += bytes - chartMemory.value( chart, 0 );
+    chartMemory.insert( chart, bytes );
+  }
+
+/*--------------------------------------------------------------------------------*/
+
+  qint64 sceneMemory( GobChartsHibernatable *chart )
+  {
+    return chartMemory.value( chart, 0 );
+  }
+
+/*--------------------------------------------------------------------------------*/
+
+  qint64 totalSceneMemory()
+  {
+    return totalMemory;
+  }
+
+/*--------------------------------------------------------------------------------*/
+
+  void setMemoryBudget( qint64 bytes )
+  {
+    budget = qMax( qint64( 0 ), bytes );
+  }
+
+/*--------------------------------------------------------------------------------*/
+
+  qint64 memoryBudget()
+  {
+    return budget;
+  }
+
+/*--------------------------------------------------------------------------------*/
+
+  void enforceMemoryBudget()
+  {
+    if( budget <= 0 || totalMemory <= budget )
+    {
+      return;
+    }
+
+    /* Hibernating doesn't change the order of the list (only showing a chart does). */
+    foreach( GobChartsHibernatable *chart, charts )
+    {
+      if( totalMemory <= budget )
+      {
+        break;
+      }
+
+      chart->hibernate();    // updates totalMemory
+    }
+  }
+
+/*--------------------------------------------------------------------------------*/
+}
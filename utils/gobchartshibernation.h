@@ -0,0 +1,80 @@
+/* Copyright (C) 2012 by William Hallatt.
+ *
+ * This file forms part of the "GobChartsWidget" library.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have downloaded a copy of the GNU General Public License
+ * (GNUGPL.txt) and GNU Lesser General Public License (GNULGPL.txt)
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * The official website for this project is www.goblincoding.com and,
+ * although not compulsory, it would be appreciated if all works of whatever
+ * nature referring to or using this library include a reference to this site.
+ */
+
+#ifndef GOBCHARTSHIBERNATION_H
+#define GOBCHARTSHIBERNATION_H
+
+#include <QtGlobal>
+
+/// A chart that can release its scene memory while it is hidden.
+
+class GobChartsHibernatable
+{
+public:
+  //! Destructor.
+  virtual ~GobChartsHibernatable() {}
+
+  /*! Releases the scene memory (and reports the new estimate via GobChartsHibernation::setSceneMemory()).
+      Returns "false" if the chart can't currently hibernate (e.g. because it is on screen). */
+  virtual bool hibernate() = 0;
+};
+
+/*--------------------------------------------------------------------------------*/
+
+/// Process-wide registry of the charts and their shared scene memory budget.
+
+/** Charts register on construction, report their scene memory estimate whenever it changes and tell the registry
+    when they are shown.  The registry keeps a running total of the estimates and, when asked to enforce the budget,
+    hibernates charts from the least to the most recently shown until the total fits.  Checking the budget is O(1),
+    the charts are only visited once it has been exceeded.  Only to be used from the GUI thread. */
+namespace GobChartsHibernation
+{
+  /*! Adds "chart" to the registry (as the most recently shown chart). */
+  void registerChart( GobChartsHibernatable *chart );
+
+  /*! Removes "chart" (and its scene memory estimate) from the registry. */
+  void unregisterChart( GobChartsHibernatable *chart );
+
+  /*! Marks "chart" as the most recently shown chart. */
+  void chartShown( GobChartsHibernatable *chart );
+
+  /*! Sets the scene memory estimate (bytes) of "chart". */
+  void setSceneMemory( GobChartsHibernatable *chart, qint64 bytes );
+
+  /*! Returns the scene memory estimate (bytes) of "chart". */
+  qint64 sceneMemory( GobChartsHibernatable *chart );
+
+  /*! Returns the sum of the scene memory estimates of all registered charts. */
+  qint64 totalSceneMemory();
+
+  /*! Sets the budget (bytes) for the scene memory of all charts, 0 removes the budget. */
+  void setMemoryBudget( qint64 bytes );
+
+  /*! Returns the scene memory budget (bytes), 0 if there is none. */
+  qint64 memoryBudget();
+
+  /*! Hibernates charts, least recently shown first, until the scene memory of all charts fits within the budget. */
+  void enforceMemoryBudget();
+}
+
+#endif // GOBCHARTSHIBERNATION_H
@@ -0,0 +1,223 @@
+/* Copyright (C) 2012 by William Hallatt.
+ *
+ * This file forms part of the "GobChartsWidget" library.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have downloaded a copy of the GNU General Public License
+ * (GNUGPL.txt) and GNU Lesser General Public License (GNULGPL.txt)
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * The official website for this project is www.goblincoding.com and,
+ * although not compulsory, it would be appreciated if all works of whatever
+ * nature referring to or using this library include a reference to this site.
+ */
+
+#include "gobchartsingestionqueue.h"
+
+/*--------------------------------------------------------------------------------*/
+
+GobChartsIngestionQueue::GobChartsIngestionQueue( int capacity, BackpressurePolicy policy ) :
+  m_buffer    ( NULLPOINTER ),
+  m_size      ( qMax( capacity, 1 ) + 1 ),
+  m_readIndex ( 0 ),
+  m_writeIndex( 0 ),
+  m_dropped   ( 0 ),
+  m_merged    ( 0 ),
+  m_overflowSize ( 0 ),
+  m_overflowMutex(),
+  m_overflowMap  (),
+  m_overflowQueue(),
+  m_policy    ( policy )
+{
+  m_buffer = new GobChartsSample[ m_size ];
+}
+
+/*--------------------------------------------------------------------------------*/
+
+GobChartsIngestionQueue::~GobChartsIngestionQueue()
+{
+  delete [] m_buffer;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+bool GobChartsIngestionQueue::push( int row, qreal value )
+{
+  GobChartsSample sample;
+  sample.row   = row;
+  sample.value = value;
+
+  /* Once samples overflowed, newer ones may not overtake them via the ring buffer.  Only the consumer
+    empties the overflow, so a size of 0 read here can't be outdated. */
+  if( m_overflowSize.fetchAndAddAcquire( 0 ) == 0 && enqueue( sample ) )
+  {
+    return true;
+  }
+
+  overflow( sample );
+  return false;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsIngestionQueue::overflow( const GobChartsSample &sample )
+{
+  QMutexLocker locker( &m_overflowMutex );
+
+  if( m_policy == Merge )
+  {
+    if( m_overflowMap.contains( sample.row ) )
+    {
+      m_merged.ref();
+    }
+
+    m_overflowMap.insert( sample.row, sample.value );
+    m_overflowSize.fetchAndStoreRelease( m_overflowMap.size() );
+  }
+  else
+  {
+    /* drain() returns at most capacity() samples, there is no point in keeping more. */
+    m_overflowQueue.enqueue( sample );
+
+    if( m_overflowQueue.size() > capacity() )
+    {
+      m_overflowQueue.dequeue();
+      m_dropped.ref();
+    }
+
+    m_overflowSize.fetchAndStoreRelease( m_overflowQueue.size() );
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+
+bool GobChartsIngestionQueue::enqueue( const GobChartsSample &sample )
+{
+  int write = m_writeIndex.fetchAndAddAcquire( 0 );
+  int next  = ( write + 1 ) % m_size;
+
+  /* The queue is full when advancing the write index would make it catch up with the read index. */
+  if( next == m_readIndex.fetchAndAddAcquire( 0 ) )
+  {
+    return false;
+  }
+
+  /* The slot at "write" is never read before the write index is published below. */
+  m_buffer[ write ] = sample;
+  m_writeIndex.fetchAndStoreRelease( next );
+  return true;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+int GobChartsIngestionQueue::drain( QVector< GobChartsSample > &samples )
+{
+  int start = samples.size();
+  drainBuffer( samples );
+
+  if( m_overflowSize.fetchAndAddAcquire( 0 ) > 0 )
+  {
+    QMutexLocker locker( &m_overflowMutex );
+
+    /* The producer may have filled the ring buffer again before it started overflowing, those samples
+      are older than the overflow.  It won't touch the ring buffer while we hold the overflow. */
+    drainBuffer( samples );
+
+    if( m_policy == Merge )
+    {
+      for( QMap< int, qreal >::const_iterator it = m_overflowMap.constBegin(); it != m_overflowMap.constEnd(); ++it )
+      {
+        GobChartsSample sample;
+        sample.row   = it.key();
+        sample.value = it.value();
+        samples.append( sample );
+      }
+
+      m_overflowMap.clear();
+    }
+    else
+    {
+      while( !m_overflowQueue.isEmpty() )
+      {
+        samples.append( m_overflowQueue.dequeue() );
+      }
+    }
+
+    m_overflowSize.fetchAndStoreRelease( 0 );
+  }
+
+  int drained = samples.size() - start;
+
+  if( m_policy == DropOldest && drained > capacity() )
+  {
+    int excess = drained - capacity();
+    samples.remove( start, excess );
+    m_dropped.fetchAndAddOrdered( excess );
+    drained = capacity();
+  }
+
+  return drained;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsIngestionQueue::drainBuffer( QVector< GobChartsSample > &samples )
+{
+  int read  = m_readIndex.fetchAndAddAcquire( 0 );
+  int write = m_writeIndex.fetchAndAddAcquire( 0 );
+
+  while( read != write )
+  {
+    samples.append( m_buffer[ read ] );
+    read = ( read + 1 ) % m_size;
+  }
+
+  /* Only now may the producer re-use the slots. */
+  m_readIndex.fetchAndStoreRelease( read );
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsIngestionQueue::setBackpressurePolicy( BackpressurePolicy policy )
+{
+  m_policy = policy;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+GobChartsIngestionQueue::BackpressurePolicy GobChartsIngestionQueue::backpressurePolicy() const
+{
+  return m_policy;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+int GobChartsIngestionQueue::capacity() const
+{
+  return m_size - 1;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+int GobChartsIngestionQueue::droppedSamples() const
+{
+  return const_cast< QAtomicInt& >( m_dropped ).fetchAndAddOrdered( 0 );
+}
+
+/*--------------------------------------------------------------------------------*/
+
+int GobChartsIngestionQueue::mergedSamples() const
+{
+  return const_cast< QAtomicInt& >( m_merged ).fetchAndAddOrdered( 0 );
+}
+
+/*--------------------------------------------------------------------------------*/
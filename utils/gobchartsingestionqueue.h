@@ -0,0 +1,119 @@
+/* Copyright (C) 2012 by William Hallatt.
+ *
+ * This file forms part of the "GobChartsWidget" library.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have downloaded a copy of the GNU General Public License
+ * (GNUGPL.txt) and GNU Lesser General Public License (GNULGPL.txt)
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * The official website for this project is www.goblincoding.com and,
+ * although not compulsory, it would be appreciated if all works of whatever
+ * nature referring to or using this library include a reference to this site.
+ */
+
+#ifndef GOBCHARTSINGESTIONQUEUE_H
+#define GOBCHARTSINGESTIONQUEUE_H
+
+#include <QAtomicInt>
+#include <QMap>
+#include <QMutex>
+#include <QQueue>
+#include <QVector>
+#include "utils/globalincludes.h"
+#include "utils/gobchartswidgetdef.h"
+#include "utils/gobchartsnocopy.h"
+
+/*! A single data sample: the new value for the given model row. */
+struct GobChartsSample
+{
+  int   row;
+  qreal value;
+};
+
+/// Lock-free single-producer/single-consumer queue for real-time data samples.
+
+/** GobChartsIngestionQueue allows a data acquisition thread (the producer) to hand samples to
+    a chart (the consumer, running on the GUI thread) without locks and without going through
+    the data model for every sample.  The chart drains the queue at a fixed rate and applies
+    all pending samples in one batch.
+
+    Exactly one thread may call push() and exactly one (other) thread may call drain().  Only the
+    producer writes to the ring buffer and only the consumer reads from it.  Samples that do not fit
+    go to an overflow area guarded by a mutex (which is therefore only locked once the queue is full),
+    and all later samples follow them there until the consumer collects the overflow during its next
+    drain().  The backpressure policy determines what the overflow holds:
+
+    - DropOldest - the overflowing samples themselves.  drain() never returns more than capacity()
+                   samples, the oldest ones are discarded.
+    - Merge      - only the latest value per row.
+
+    As with the data and selection models, GobChartsWidget does NOT take ownership of the queue. */
+class GOBCHARTSWIDGETSHARED_EXPORT GobChartsIngestionQueue : public GobChartsNoCopy
+{
+public:
+  /*! Determines what happens when the queue is full. */
+  enum BackpressurePolicy { DropOldest, Merge };
+
+  //! Constructor.
+  explicit GobChartsIngestionQueue( int capacity = 4096, BackpressurePolicy policy = DropOldest );
+
+  //! Destructor.
+  ~GobChartsIngestionQueue();
+
+  /*! Producer only. Queues a new value for "row".  Returns "false" if the sample did not fit into
+      the ring buffer and went to the overflow instead (see BackpressurePolicy). */
+  bool push( int row, qreal value );
+
+  /*! Consumer only. Appends all pending samples (including those in the overflow) to "samples" in the
+      order in which they were pushed and returns the number of samples drained. */
+  int drain( QVector< GobChartsSample > &samples );
+
+  /*! Sets the backpressure policy.  This must be done before the producer starts pushing samples. */
+  void setBackpressurePolicy( BackpressurePolicy policy );
+
+  /*! Returns the current backpressure policy. */
+  BackpressurePolicy backpressurePolicy() const;
+
+  /*! Returns the maximum number of samples the queue can hold. */
+  int capacity() const;
+
+  /*! Returns the number of samples discarded under the DropOldest policy. */
+  int droppedSamples() const;
+
+  /*! Returns the number of samples that were superseded in the overflow map under the Merge policy. */
+  int mergedSamples() const;
+
+private:
+  /* Producer only. Returns "true" if the sample was written to the ring buffer. */
+  bool enqueue( const GobChartsSample &sample );
+
+  /* Producer only. Adds the sample to the overflow. */
+  void overflow( const GobChartsSample &sample );
+
+  /* Consumer only. Appends the samples in the ring buffer to "samples". */
+  void drainBuffer( QVector< GobChartsSample > &samples );
+
+  GobChartsSample   *m_buffer;
+  int                m_size;           // capacity + 1, one slot always remains empty
+  QAtomicInt         m_readIndex;      // advanced by the consumer only
+  QAtomicInt         m_writeIndex;     // advanced by the producer only
+  QAtomicInt         m_dropped;
+  QAtomicInt         m_merged;
+  QAtomicInt         m_overflowSize;   // number of samples in the overflow, read without locking
+  QMutex             m_overflowMutex;
+  QMap< int, qreal > m_overflowMap;    // Merge
+  QQueue< GobChartsSample > m_overflowQueue;   // DropOldest
+  BackpressurePolicy m_policy;
+};
+
+#endif // GOBCHARTSINGESTIONQUEUE_H
@@ -0,0 +1,671 @@
+/* Copyright (C) 2012 by William Hallatt.
+ *
+ * This file forms part of the "GobChartsWidget" library.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have downloaded a copy of the GNU General Public License
+ * (GNUGPL.txt) and GNU Lesser General Public License (GNULGPL.txt)
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * The official website for this project is www.goblincoding.com and,
+ * although not compulsory, it would be appreciated if all works of whatever
+ * nature referring to or using this library include a reference to this site.
+ */
+
+#include "gobchartslayout.h"
+#include "utils/gobchartscolours.h"
+
+#include <QtCore/qmath.h>
+#include <algorithm>
+
+/*--------------------------------------------------------------------------------*/
+
+const int   BAR_SPACING        = 5;
+const qreal FULL_ELLIPSE       = 5760;    // span angles in 16th of a degree (360*16)
+const qreal PI                 = 3.14159265358979323846;
+
+/* Arbitrary number selected on the basis of the resulting cosmetic appearance. */
+const qreal STRIPSPACE_OFFSET  = 0.05;
+
+/* Number of items processed between checks for a newer layout request. */
+const int   CANCEL_CHECK_STEP  = 256;
+
+/* Minimum width (in scene coordinates) per item in the displayed range before aggregated buckets are shown instead. */
+const qreal ZOOM_ITEM_WIDTH    = 2.0;
+
+
+/*------------------------------- SNAPSHOT/GEOMETRY ------------------------------*/
+
+GobChartsDataSnapshot::GobChartsDataSnapshot() :
+  rows            (),
+  categories      (),
+  values          (),
+  visiblePositions(),
+  fixedColour     (),
+  totalValue      ( 0.0 ),
+  maxValue        ( 0.0 ),
+  useFixedColour  ( false ),
+  version         ( 0 ),
+  rangeFirst      ( -1 ),
+  rangeLast       ( -1 ),
+  pyramid         ()
+{
+}
+
+/*--------------------------------------------------------------------------------*/
+
+int GobChartsDataSnapshot::size() const
+{
+  return rows.size();
+}
+
+/*--------------------------------------------------------------------------------*/
+
+GobChartsGeometryItem::GobChartsGeometryItem() :
+  rect         (),
+  point        (),
+  previousPoint(),
+  span         (),
+  colour       (),
+  legendText   ( "" ),
+  value        ( 0.0 ),
+  position     ( -1 ),
+  row          ( -1 ),
+  startAngle   ( 0 ),
+  spanAngle    ( 0 )
+{
+}
+
+/*--------------------------------------------------------------------------------*/
+
+GobChartsGeometry::GobChartsGeometry() :
+  items    (),
+  innerRect(),
+  type     ( BAR ),
+  version  ( 0 ),
+  cancelled( false )
+{
+}
+
+
+/*------------------------ NONMEMBER UTILITY FUNCTIONS ---------------------------*/
+
+namespace
+{
+  /* Returns "true" if a newer layout request has been made since "snapshot" was taken. */
+  bool IsSuperseded( const GobChartsDataSnapshot &snapshot, QAtomicInt *latestVersion )
+  {
+    return latestVersion && ( latestVersion->fetchAndAddOrdered( 0 ) != snapshot.version );
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Fills in the item details shared by all chart types. */
+  GobChartsGeometryItem BaseItem( const GobChartsDataSnapshot &snapshot, int position )
+  {
+    GobChartsGeometryItem item;
+    item.position   = position;
+    item.row        = snapshot.rows.at( position );
+    item.value      = snapshot.values.at( position );
+    item.colour     = snapshot.useFixedColour ? snapshot.fixedColour : GobChartsColours::colourAt( position );
+    item.legendText = QString( "%1 - %2" ).arg( snapshot.categories.at( position ) ).arg( item.value );
+    return item;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  qreal DataPercentage( const GobChartsDataSnapshot &snapshot, qreal value )
+  {
+    return ( snapshot.totalValue > 0.0 ) ? ( value/snapshot.totalValue ) : 0.0;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Returns the y coordinate corresponding to "perc" for BAR and LINE charts. */
+  qreal ValueY( const GobChartsDataSnapshot &snapshot, const QRectF &innerRect, qreal perc )
+  {
+    return innerRect.bottom()
+           - GobChartsLayout::stripSpace( snapshot.maxValue, snapshot.totalValue, innerRect.height(), perc )
+           - perc * innerRect.height();
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Returns the visible positions from "first" up to and including "last". */
+  QList< int > VisibleRange( const GobChartsDataSnapshot &snapshot, int first, int last )
+  {
+    QList< int >::const_iterator begin = std::lower_bound( snapshot.visiblePositions.constBegin(), snapshot.visiblePositions.constEnd(), first );
+    QList< int >::const_iterator end   = std::upper_bound( begin, snapshot.visiblePositions.constEnd(), last );
+
+    return snapshot.visiblePositions.mid( static_cast< int >( begin - snapshot.visiblePositions.constBegin() ),
+                                          static_cast< int >( end - begin ) );
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Returns the number of visible positions from "first" up to and including "last". */
+  int VisibleCount( const GobChartsDataSnapshot &snapshot, int first, int last )
+  {
+    QList< int >::const_iterator begin = std::lower_bound( snapshot.visiblePositions.constBegin(), snapshot.visiblePositions.constEnd(), first );
+    QList< int >::const_iterator end   = std::upper_bound( begin, snapshot.visiblePositions.constEnd(), last );
+    return static_cast< int >( end - begin );
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Sets "first" and "last" to the range of positions a chart of type "type" lays out and returns "true" if
+    the range holds more positions than can be told apart, in which case (up to) "maxItems" pyramid buckets are
+    laid out instead.  The snapshot must not be empty. */
+  bool DisplayedRange( GobChartsType type, const GobChartsDataSnapshot &snapshot, const QRectF &innerRect,
+                       int &first, int &last, int &maxItems )
+  {
+    first    = 0;
+    last     = snapshot.size() - 1;
+    maxItems = GobChartsLayout::maxDistinctPositions( innerRect );
+
+    if( type == PIE )
+    {
+      return false;
+    }
+
+    if( snapshot.rangeFirst >= 0 )
+    {
+      first = qBound( 0, snapshot.rangeFirst, last );
+      last  = qBound( first, snapshot.rangeLast, last );
+    }
+
+    /* More positions than can be told apart, show the summary instead. */
+    return ( last - first + 1 > maxItems ) && ( snapshot.pyramid.size() == snapshot.size() );
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Lays out the bar of "position" in columns of "barColWidth", "first" being the position in the left-most column. */
+  GobChartsGeometryItem BarItem( const GobChartsDataSnapshot &snapshot, const QRectF &inner, qreal barColWidth, int first, int position )
+  {
+    GobChartsGeometryItem item = BaseItem( snapshot, position );
+    qreal dataPercentage = DataPercentage( snapshot, item.value );
+
+    QPointF topLeft;
+    QPointF bottomRight( inner.left() + barColWidth * ( position - first ) + barColWidth - BAR_SPACING, inner.bottom() );
+
+    if( dataPercentage < 0.01 )
+    {
+      /* If we don't have at least a snippet of a graphics item, a lot of the selection model's functionality
+        doesn't work as well as it could.  Create at least the semblance of a bar if the value is zero. */
+      topLeft = QPointF( inner.left() + barColWidth * ( position - first ), inner.bottom() - 1 /* pixel */ );
+    }
+    else
+    {
+      topLeft = QPointF( inner.left() + barColWidth * ( position - first ), ValueY( snapshot, inner, dataPercentage ) );
+    }
+
+    item.rect  = QRectF( topLeft, bottomRight );
+    item.point = QPointF( item.rect.center().x(), item.rect.top() );
+    return item;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Lays out positions "first" to "last" across the full width of the inner rectangle. */
+  void LayoutBar( GobChartsGeometry &geometry, const GobChartsDataSnapshot &snapshot, int first, int last, QAtomicInt *latestVersion )
+  {
+    qreal barColWidth = geometry.innerRect.width()/( last - first + 1 );
+    int   count( 0 );
+
+    foreach( int position, VisibleRange( snapshot, first, last ) )
+    {
+      if( ( ++count % CANCEL_CHECK_STEP == 0 ) && IsSuperseded( snapshot, latestVersion ) )
+      {
+        geometry.cancelled = true;
+        return;
+      }
+
+      geometry.items.append( BarItem( snapshot, geometry.innerRect, barColWidth, first, position ) );
+    }
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Lays out positions "first" to "last" across the full width of the inner rectangle. */
+  void LayoutLine( GobChartsGeometry &geometry, const GobChartsDataSnapshot &snapshot, int first, int last, QAtomicInt *latestVersion )
+  {
+    const QRectF &inner = geometry.innerRect;
+    qreal   pointSpacing = inner.width()/( last - first + 1 );
+    QPointF previous( inner.left(), inner.bottom() );
+    int     count( 0 );
+
+    foreach( int position, VisibleRange( snapshot, first, last ) )
+    {
+      if( ( ++count % CANCEL_CHECK_STEP == 0 ) && IsSuperseded( snapshot, latestVersion ) )
+      {
+        geometry.cancelled = true;
+        return;
+      }
+
+      GobChartsGeometryItem item = BaseItem( snapshot, position );
+      qreal dataPercentage = DataPercentage( snapshot, item.value );
+
+      item.point         = QPointF( inner.left() + pointSpacing * ( position - first ) + pointSpacing/2,
+                                    ValueY( snapshot, inner, dataPercentage ) );
+      item.previousPoint = previous;
+      item.rect          = QRectF( item.point, item.point );
+      geometry.items.append( item );
+
+      previous = item.point;
+    }
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Lays out the pyramid buckets summarising positions "first" to "last" (BAR and LINE), one item per
+    bucket: bars reach up to the bucket maximum, lines connect the bucket maxima and show each bucket's
+    minimum to maximum span. */
+  void LayoutBuckets( GobChartsGeometry &geometry, const GobChartsDataSnapshot &snapshot, int first, int last, int maxBuckets )
+  {
+    const QRectF &inner = geometry.innerRect;
+    qreal positionWidth = inner.width()/( last - first + 1 );
+
+    QPointF previous( inner.left(), inner.bottom() );
+
+    QVector< GobChartsPyramidBucket > buckets;
+    snapshot.pyramid.query( first, last, maxBuckets, buckets );
+    geometry.items.reserve( buckets.size() );
+
+    foreach( const GobChartsPyramidBucket &bucket, buckets )
+    {
+      if( bucket.count == 0 )
+      {
+        continue;
+      }
+
+      /* Buckets at the edges may extend beyond the range. */
+      int   bucketFirst = qMax( bucket.first, first );
+      int   bucketLast  = qMin( bucket.last,  last );
+      qreal left        = inner.left() + positionWidth * ( bucketFirst - first );
+      qreal right       = inner.left() + positionWidth * ( bucketLast - first + 1 );
+      qreal maxY        = ValueY( snapshot, inner, DataPercentage( snapshot, bucket.max ) );
+      qreal minY        = ValueY( snapshot, inner, DataPercentage( snapshot, bucket.min ) );
+
+      GobChartsGeometryItem item = BaseItem( snapshot, bucketFirst );
+      item.value      = bucket.max;
+      item.legendText = QString( "%1 .. %2 - %3" ).arg( snapshot.categories.at( bucketFirst ) )
+                                                  .arg( snapshot.categories.at( bucketLast ) )
+                                                  .arg( bucket.max );
+
+      if( geometry.type == BAR )
+      {
+        item.rect  = QRectF( QPointF( left, qMin( maxY, inner.bottom() - 1 /* pixel */ ) ), QPointF( right, inner.bottom() ) );
+        item.point = QPointF( item.rect.center().x(), item.rect.top() );
+      }
+      else
+      {
+        item.point         = QPointF( ( left + right )/2, maxY );
+        item.previousPoint = previous;
+        item.span          = QLineF( ( left + right )/2, minY, ( left + right )/2, maxY );
+        item.rect          = QRectF( item.point, item.point );
+        previous           = item.point;
+      }
+
+      geometry.items.append( item );
+    }
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Ordering predicates for the binary searches in hitTest(), rangeQuery() and lowerBoundRow(). */
+  bool RightLessThanX( const GobChartsGeometryItem &item, qreal x )
+  {
+    return item.rect.right() < x;
+  }
+
+  bool XLessThanLeft( qreal x, const GobChartsGeometryItem &item )
+  {
+    return x < item.rect.left();
+  }
+
+  bool XLessThanPointX( qreal x, const GobChartsGeometryItem &item )
+  {
+    return x < item.point.x();
+  }
+
+  bool RowLessThan( const GobChartsGeometryItem &item, int row )
+  {
+    return item.row < row;
+  }
+
+  bool PointXLessThanX( const GobChartsGeometryItem &item, qreal x )
+  {
+    return item.point.x() < x;
+  }
+
+  bool StopAngleLessThan( const GobChartsGeometryItem &item, int angle )
+  {
+    return ( item.startAngle + item.spanAngle ) <= angle;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  void LayoutPie( GobChartsGeometry &geometry, const GobChartsDataSnapshot &snapshot, QAtomicInt *latestVersion )
+  {
+    QRectF pieRectangle( geometry.innerRect );
+    int    lastStopAngle( 0 );
+    int    count( 0 );
+
+    foreach( int position, snapshot.visiblePositions )
+    {
+      if( ( ++count % CANCEL_CHECK_STEP == 0 ) && IsSuperseded( snapshot, latestVersion ) )
+      {
+        geometry.cancelled = true;
+        return;
+      }
+
+      GobChartsGeometryItem item = BaseItem( snapshot, position );
+
+      item.rect       = pieRectangle;
+      item.point      = pieRectangle.center();
+      item.startAngle = lastStopAngle;
+      item.spanAngle  = qRound( DataPercentage( snapshot, item.value ) * FULL_ELLIPSE );
+      geometry.items.append( item );
+
+      lastStopAngle += item.spanAngle;
+    }
+  }
+}
+
+
+/*----------------------------------- LAYOUT -------------------------------------*/
+
+namespace GobChartsLayout
+{
+  GobChartsGeometry calculate( GobChartsType type,
+                               const GobChartsDataSnapshot &snapshot,
+                               const QRectF &innerRect,
+                               QAtomicInt *latestVersion )
+  {
+    GobChartsGeometry geometry;
+    geometry.type      = type;
+    geometry.version   = snapshot.version;
+    geometry.innerRect = innerRect;
+
+    if( snapshot.size() > 0 )
+    {
+      int first( 0 ), last( 0 ), maxItems( 0 );
+
+      if( DisplayedRange( type, snapshot, innerRect, first, last, maxItems ) )
+      {
+        LayoutBuckets( geometry, snapshot, first, last, maxItems );
+        return geometry;
+      }
+
+      geometry.items.reserve( VisibleCount( snapshot, first, last ) );
+
+      switch( type )
+      {
+      case BAR:
+        LayoutBar( geometry, snapshot, first, last, latestVersion );
+        break;
+      case PIE:
+        LayoutPie( geometry, snapshot, latestVersion );
+        break;
+      case LINE:
+        LayoutLine( geometry, snapshot, first, last, latestVersion );
+        break;
+      }
+    }
+
+    return geometry;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  GobChartsGeometry calculateBarWindow( const GobChartsDataSnapshot &snapshot, const QRectF &contentRect, qreal left, qreal right )
+  {
+    GobChartsGeometry geometry;
+    geometry.type      = BAR;
+    geometry.version   = snapshot.version;
+    geometry.innerRect = contentRect;
+
+    if( snapshot.size() > 0 && right >= left )
+    {
+      /* Columns are equally wide, the positions in the window follow directly from its edges. */
+      qreal barColWidth = contentRect.width()/snapshot.size();
+      int   first       = qBound( 0, qFloor( ( left - contentRect.left() )/barColWidth ), snapshot.size() - 1 );
+      int   last        = qBound( first, qFloor( ( right - contentRect.left() )/barColWidth ), snapshot.size() - 1 );
+
+      foreach( int position, VisibleRange( snapshot, first, last ) )
+      {
+        geometry.items.append( BarItem( snapshot, contentRect, barColWidth, 0, position ) );
+      }
+    }
+
+    return geometry;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  QRectF barColumn( const GobChartsDataSnapshot &snapshot, const QRectF &contentRect, int position )
+  {
+    qreal barColWidth = contentRect.width()/qMax( 1, snapshot.size() );
+    return QRectF( contentRect.left() + barColWidth * position, contentRect.top(), barColWidth - BAR_SPACING, contentRect.height() );
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  GobChartsGeometryItem baseItem( const GobChartsDataSnapshot &snapshot, int position )
+  {
+    return BaseItem( snapshot, position );
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  int maxDistinctPositions( const QRectF &innerRect )
+  {
+    return qMax( 1, qFloor( innerRect.width()/ZOOM_ITEM_WIDTH ) );
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  int itemCount( GobChartsType type, const GobChartsDataSnapshot &snapshot, const QRectF &innerRect )
+  {
+    if( snapshot.size() == 0 )
+    {
+      return 0;
+    }
+
+    int first( 0 ), last( 0 ), maxItems( 0 );
+
+    if( DisplayedRange( type, snapshot, innerRect, first, last, maxItems ) )
+    {
+      return maxItems + 2;    // the buckets at the edges may be partial
+    }
+
+    return VisibleCount( snapshot, first, last );
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* The maximum value is used to determine the available "free space" at the top
+    of the chart (BAR and LINE), i.e. the space that will not be entered into by any of the
+    categories, so we'll strip this space out to maximise visual effect. */
+  qreal stripSpace( qreal maxValue, qreal totalValue, qreal height, qreal perc )
+  {
+    if( totalValue > 0.0 && maxValue > 0.0 )
+    {
+      /* I know, this calculation looks nasty, but it really isn't. */
+      qreal maxStrip = height - ( ( maxValue/totalValue ) + STRIPSPACE_OFFSET ) * height;
+      return ( perc/( maxValue/totalValue ) ) * maxStrip;
+    }
+
+    return 0;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  int hitTest( const GobChartsGeometry &geometry, const QPointF &point, qreal radius )
+  {
+    const QVector< GobChartsGeometryItem > &items = geometry.items;
+
+    if( items.isEmpty() )
+    {
+      return -1;
+    }
+
+    switch( geometry.type )
+    {
+    case BAR:
+      {
+        /* Bars are ordered by x and don't overlap. */
+        QVector< GobChartsGeometryItem >::const_iterator it =
+            std::lower_bound( items.constBegin(), items.constEnd(), point.x(), RightLessThanX );
+
+        if( it != items.constEnd() && it->rect.contains( point ) )
+        {
+          return static_cast< int >( it - items.constBegin() );
+        }
+      }
+      break;
+    case LINE:
+      {
+        /* Of the two points either side of "x", pick the closer one. */
+        QVector< GobChartsGeometryItem >::const_iterator it =
+            std::lower_bound( items.constBegin(), items.constEnd(), point.x(), PointXLessThanX );
+
+        int   best( -1 );
+        qreal bestDistance( radius * radius );
+
+        for( int i = static_cast< int >( it - items.constBegin() ) - 1; i <= static_cast< int >( it - items.constBegin() ); i++ )
+        {
+          if( i >= 0 && i < items.size() )
+          {
+            QPointF delta = items.at( i ).point - point;
+            qreal distance = delta.x() * delta.x() + delta.y() * delta.y();
+
+            if( distance <= bestDistance )
+            {
+              best = i;
+              bestDistance = distance;
+            }
+          }
+        }
+
+        return best;
+      }
+    case PIE:
+      {
+        const QRectF &rect = items.first().rect;
+        qreal dx = ( point.x() - rect.center().x() )/( rect.width()/2 );
+        qreal dy = ( point.y() - rect.center().y() )/( rect.height()/2 );
+
+        if( rect.isEmpty() || dx * dx + dy * dy > 1.0 )
+        {
+          return -1;
+        }
+
+        /* Qt angles run counter-clockwise from three o'clock in 16ths of a degree (and y points down). */
+        qreal degrees = qAtan2( -dy, dx ) * 180.0/PI;
+        int   angle   = qRound( ( degrees < 0 ? degrees + 360.0 : degrees ) * 16 );
+
+        QVector< GobChartsGeometryItem >::const_iterator it =
+            std::lower_bound( items.constBegin(), items.constEnd(), angle, StopAngleLessThan );
+
+        if( it != items.constEnd() && angle >= it->startAngle )
+        {
+          return static_cast< int >( it - items.constBegin() );
+        }
+      }
+      break;
+    }
+
+    return -1;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  bool rangeQuery( const GobChartsGeometry &geometry, qreal left, qreal right, int &first, int &last )
+  {
+    const QVector< GobChartsGeometryItem > &items = geometry.items;
+    QVector< GobChartsGeometryItem >::const_iterator begin = items.constEnd();
+    QVector< GobChartsGeometryItem >::const_iterator end   = items.constEnd();
+
+    switch( geometry.type )
+    {
+    case BAR:
+      /* Bars that overlap [left, right] at all. */
+      begin = std::lower_bound( items.constBegin(), items.constEnd(), left,  RightLessThanX );
+      end   = std::upper_bound( items.constBegin(), items.constEnd(), right, XLessThanLeft );
+      break;
+    case LINE:
+      begin = std::lower_bound( items.constBegin(), items.constEnd(), left,  PointXLessThanX );
+      end   = std::upper_bound( items.constBegin(), items.constEnd(), right, XLessThanPointX );
+      break;
+    case PIE:
+      break;
+    }
+
+    if( begin >= end )
+    {
+      return false;
+    }
+
+    first = static_cast< int >( begin - items.constBegin() );
+    last  = static_cast< int >( end - items.constBegin() ) - 1;
+    return true;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  qreal barContentWidth( int count, qreal minimumBarWidth )
+  {
+    /* See LayoutBar(), the spacing is taken out of each bar's column. */
+    return count * ( minimumBarWidth + BAR_SPACING );
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  int lowerBoundRow( const GobChartsGeometry &geometry, int row )
+  {
+    return static_cast< int >( std::lower_bound( geometry.items.constBegin(), geometry.items.constEnd(), row, RowLessThan ) -
+                               geometry.items.constBegin() );
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  QPointF anchorPoint( const GobChartsGeometry &geometry, int index )
+  {
+    if( index < 0 || index >= geometry.items.size() )
+    {
+      return QPointF();
+    }
+
+    const GobChartsGeometryItem &item = geometry.items.at( index );
+
+    switch( geometry.type )
+    {
+    case BAR:
+      return item.rect.center();
+    case LINE:
+      return item.point;
+    case PIE:
+      {
+        /* Half way out along the segment's bisector. */
+        qreal radians = ( item.startAngle + item.spanAngle/2.0 )/16.0 * PI/180.0;
+        return QPointF( item.rect.center().x() + qCos( radians ) * item.rect.width()/4,
+                        item.rect.center().y() - qSin( radians ) * item.rect.height()/4 );
+      }
+    }
+
+    return item.rect.center();
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
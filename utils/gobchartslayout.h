@@ -0,0 +1,177 @@
+/* Copyright (C) 2012 by William Hallatt.
+ *
+ * This file forms part of the "GobChartsWidget" library.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have downloaded a copy of the GNU General Public License
+ * (GNUGPL.txt) and GNU Lesser General Public License (GNULGPL.txt)
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * The official website for this project is www.goblincoding.com and,
+ * although not compulsory, it would be appreciated if all works of whatever
+ * nature referring to or using this library include a reference to this site.
+ */
+
+#ifndef GOBCHARTSLAYOUT_H
+#define GOBCHARTSLAYOUT_H
+
+#include <QAtomicInt>
+#include <QColor>
+#include <QLineF>
+#include <QList>
+#include <QRectF>
+#include <QString>
+#include <QVector>
+#include "utils/globalincludes.h"
+#include "utils/gobchartsdatapyramid.h"
+
+/// Immutable copy of the chart data used as input to the layout calculations.
+
+/** A snapshot is taken on the GUI thread and contains everything the layout functions
+    need to know about the data and the relevant view settings, so that the geometry can
+    be calculated without touching the model or the view (i.e. on any thread). */
+struct GobChartsDataSnapshot
+{
+  QVector< int >     rows;              // model rows of all valid items, in row order
+  QVector< QString > categories;        // category names, indexed by position
+  QVector< qreal >   values;            // data values, indexed by position
+  QList< int >       visiblePositions;  // positions within the allowed data range, ascending
+  QColor             fixedColour;
+  qreal              totalValue;
+  qreal              maxValue;
+  bool               useFixedColour;
+  int                version;           // incremented for every new layout request
+  int                rangeFirst;        // first position of the zoomed range, -1 if not zoomed (BAR and LINE)
+  int                rangeLast;         // last position of the zoomed range
+  GobChartsDataPyramid pyramid;         // only built while the displayed range holds more positions than can be told apart
+
+  //! Constructor.
+  GobChartsDataSnapshot();
+
+  /*! Returns the number of valid items in the snapshot. */
+  int size() const;
+};
+
+/*--------------------------------------------------------------------------------*/
+
+/// Geometry calculated for a single chart item.
+
+/** Not all members are relevant to all chart types:
+
+    - BAR  - "rect" is the bar's rectangle.
+    - PIE  - "rect" is the pie's bounding rectangle, "startAngle" and "spanAngle" describe the segment.
+    - LINE - "point" is the data point and "previousPoint" the start of the segment leading up to it.  Pyramid
+             buckets additionally have a "span" from the bucket minimum to its maximum.
+*/
+struct GobChartsGeometryItem
+{
+  QRectF  rect;
+  QPointF point;
+  QPointF previousPoint;
+  QLineF  span;           // LINE pyramid buckets only, null otherwise
+  QColor  colour;
+  QString legendText;
+  qreal   value;
+  int     position;       // index into the snapshot's valid items
+  int     row;            // model row
+  int     startAngle;     // 16ths of a degree
+  int     spanAngle;      // 16ths of a degree
+
+  //! Constructor.
+  GobChartsGeometryItem();
+};
+
+/*--------------------------------------------------------------------------------*/
+
+/// The result of a layout calculation.
+
+/** Items are stored in ascending position order, which means that the x positions of
+    BAR and LINE items increase monotonically. */
+struct GobChartsGeometry
+{
+  QVector< GobChartsGeometryItem > items;
+  QRectF        innerRect;
+  GobChartsType type;
+  int           version;      // the version of the snapshot this geometry was calculated from
+  bool          cancelled;    // "true" if a newer request superseded this calculation
+
+  //! Constructor.
+  GobChartsGeometry();
+};
+
+/*--------------------------------------------------------------------------------*/
+
+/// Pure layout functions.
+
+/** These functions map a data snapshot and the inner scene rectangle to chart geometry.  They
+    have no side effects and do not access any QObject, which means that they may safely be
+    run on a worker thread. */
+namespace GobChartsLayout
+{
+  /*! Calculates the geometry of all visible items for a chart of type "type".  When the snapshot is zoomed
+      into a range of positions (BAR and LINE), only that range is laid out across the inner rectangle.  If the
+      displayed range (zoomed or not) holds more positions than maxDistinctPositions() and the snapshot carries
+      a pyramid, its buckets are laid out instead.
+      @param latestVersion - if provided, the calculation is abandoned (and the result flagged as
+                             cancelled) as soon as its value no longer matches the snapshot's version. */
+  GobChartsGeometry calculate( GobChartsType type,
+                               const GobChartsDataSnapshot &snapshot,
+                               const QRectF &innerRect,
+                               QAtomicInt *latestVersion = 0 );
+
+  /*! Calculates the geometry of only those BAR chart items (laid out across "contentRect", unzoomed) whose columns
+      overlap the horizontal range "left" to "right".  The cost depends on the width of the range, not on the size of
+      the snapshot, which is what makes scrolling mode independent of the amount of data. */
+  GobChartsGeometry calculateBarWindow( const GobChartsDataSnapshot &snapshot, const QRectF &contentRect, qreal left, qreal right );
+
+  /*! Returns the horizontal extent of the bar at "position" in a BAR chart laid out (unzoomed) across "contentRect"
+      (the rectangle spans the full height of "contentRect"). */
+  QRectF barColumn( const GobChartsDataSnapshot &snapshot, const QRectF &contentRect, int position );
+
+  /*! Returns the item for "position" with everything but its geometry (row, value, colour and legend text) filled in. */
+  GobChartsGeometryItem baseItem( const GobChartsDataSnapshot &snapshot, int position );
+
+  /*! Returns the number of positions that can be told apart across "innerRect" (BAR and LINE).  Displayed
+      ranges holding more positions than this are summarised by the snapshot's pyramid. */
+  int maxDistinctPositions( const QRectF &innerRect );
+
+  /*! Returns the (maximum) number of items calculate() produces for the same arguments, without calculating them. */
+  int itemCount( GobChartsType type, const GobChartsDataSnapshot &snapshot, const QRectF &innerRect );
+
+  /*! Calculates the amount of space at the top of the inner rectangle that will not be entered into
+      by any of the items (BAR and LINE).  This space is stripped from all item height calculations.
+      \sa GobChartsView::stripSpace() */
+  qreal stripSpace( qreal maxValue, qreal totalValue, qreal height, qreal perc );
+
+  /*! Returns the index (into geometry.items) of the item at "point", or -1 if there is none.  BAR and LINE
+      items are found with a binary search on x, PIE segments with a binary search on the angle.
+      @param radius - the distance within which a LINE data point counts as hit. */
+  int hitTest( const GobChartsGeometry &geometry, const QPointF &point, qreal radius = 4.0 );
+
+  /*! Finds the contiguous range of BAR or LINE items whose x extent (bar) or data point (line) falls within
+      "left" and "right" with two binary searches.  On success, "first" and "last" are set to the indices (into
+      geometry.items) of the first and last items in the range and "true" is returned.  PIE charts have no x
+      ordering and always return "false". */
+  bool rangeQuery( const GobChartsGeometry &geometry, qreal left, qreal right, int &first, int &last );
+
+  /*! Returns the width a BAR chart of "count" items needs for every bar to be at least "minimumBarWidth" wide. */
+  qreal barContentWidth( int count, qreal minimumBarWidth );
+
+  /*! Returns the index (into geometry.items) of the first item representing model row "row" or a later row,
+      which is geometry.items.size() if there is none (items are in ascending row order). */
+  int lowerBoundRow( const GobChartsGeometry &geometry, int row );
+
+  /*! Returns a point that is guaranteed to lie on the item (e.g. for selecting it programmatically). */
+  QPointF anchorPoint( const GobChartsGeometry &geometry, int index );
+}
+
+#endif // GOBCHARTSLAYOUT_H
@@ -0,0 +1,147 @@
+/* Copyright (C) 2012 by William Hallatt.
+ *
+ * This file forms part of the "GobChartsWidget" library.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have downloaded a copy of the GNU General Public License
+ * (GNUGPL.txt) and GNU Lesser General Public License (GNULGPL.txt)
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * The official website for this project is www.goblincoding.com and,
+ * although not compulsory, it would be appreciated if all works of whatever
+ * nature referring to or using this library include a reference to this site.
+ */
+
+#include "gobchartsstreambuffer.h"
+
+/*--------------------------------------------------------------------------------*/
+
+GobChartsStreamBuffer::GobChartsStreamBuffer( int capacity ) :
+  m_values   (),
+  m_maxDeque (),
+  m_nextIndex( 0 ),
+  m_size     ( 0 ),
+  m_dequeHead( 0 ),
+  m_dequeSize( 0 )
+{
+  setCapacity( capacity );
+}
+
+/*--------------------------------------------------------------------------------*/
+
+GobChartsStreamBuffer::~GobChartsStreamBuffer()
+{
+  // Default destructor
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsStreamBuffer::setCapacity( int capacity )
+{
+  capacity = qMax( capacity, 1 );
+  m_values.fill( 0.0, capacity );
+  m_maxDeque.fill( 0, capacity );
+  clear();
+}
+
+/*--------------------------------------------------------------------------------*/
+
+int GobChartsStreamBuffer::capacity() const
+{
+  return m_values.size();
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsStreamBuffer::clear()
+{
+  m_nextIndex = 0;
+  m_size      = 0;
+  m_dequeHead = 0;
+  m_dequeSize = 0;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+bool GobChartsStreamBuffer::append( qreal value )
+{
+  const int cap = capacity();
+  bool evicted  = ( m_size == cap );
+
+  m_values[ m_nextIndex % cap ] = value;
+
+  if( !evicted )
+  {
+    m_size++;
+  }
+
+  /* Candidates that are not larger than the new value can never be the maximum again. */
+  while( m_dequeSize > 0 && valueAt( m_maxDeque.at( ( m_dequeHead + m_dequeSize - 1 ) % cap ) ) <= value )
+  {
+    m_dequeSize--;
+  }
+
+  /* The candidate at the front may have slid out of the window. */
+  if( m_dequeSize > 0 && m_maxDeque.at( m_dequeHead ) < m_nextIndex - cap + 1 )
+  {
+    m_dequeHead = ( m_dequeHead + 1 ) % cap;
+    m_dequeSize--;
+  }
+
+  m_maxDeque[ ( m_dequeHead + m_dequeSize ) % cap ] = m_nextIndex;
+  m_dequeSize++;
+  m_nextIndex++;
+
+  return evicted;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+int GobChartsStreamBuffer::size() const
+{
+  return m_size;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+qreal GobChartsStreamBuffer::at( int i ) const
+{
+  return valueAt( firstIndex() + i );
+}
+
+/*--------------------------------------------------------------------------------*/
+
+qint64 GobChartsStreamBuffer::firstIndex() const
+{
+  return m_nextIndex - m_size;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+qreal GobChartsStreamBuffer::maximum() const
+{
+  if( m_dequeSize > 0 )
+  {
+    return valueAt( m_maxDeque.at( m_dequeHead ) );
+  }
+
+  return 0.0;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+qreal GobChartsStreamBuffer::valueAt( qint64 index ) const
+{
+  return m_values.at( static_cast< int >( index % capacity() ) );
+}
+
+/*--------------------------------------------------------------------------------*/
@@ -0,0 +1,83 @@
+/* Copyright (C) 2012 by William Hallatt.
+ *
+ * This file forms part of the "GobChartsWidget" library.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have downloaded a copy of the GNU General Public License
+ * (GNUGPL.txt) and GNU Lesser General Public License (GNULGPL.txt)
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * The official website for this project is www.goblincoding.com and,
+ * although not compulsory, it would be appreciated if all works of whatever
+ * nature referring to or using this library include a reference to this site.
+ */
+
+#ifndef GOBCHARTSSTREAMBUFFER_H
+#define GOBCHARTSSTREAMBUFFER_H
+
+#include <QVector>
+#include "utils/gobchartsnocopy.h"
+
+/// Fixed-size sliding window over a stream of data values.
+
+/** GobChartsStreamBuffer keeps the last capacity() values appended to it in a circular buffer, i.e.
+    appending a value to a full buffer evicts the oldest value in O(1).  Alongside the values, a monotonic
+    deque of candidate maxima is maintained so that the maximum value within the window is also available
+    in O(1) (amortised) without rescanning the window. \n
+
+    Every appended value is assigned an absolute (ever increasing) sample index, which allows callers to
+    position samples consistently while the window slides. */
+class GobChartsStreamBuffer : public GobChartsNoCopy
+{
+public:
+  //! Constructor.
+  explicit GobChartsStreamBuffer( int capacity = 100 );
+
+  //! Destructor.
+  ~GobChartsStreamBuffer();
+
+  /*! Sets the window size and clears the buffer. */
+  void setCapacity( int capacity );
+
+  /*! Returns the window size. */
+  int capacity() const;
+
+  /*! Removes all values (sample indices restart at zero). */
+  void clear();
+
+  /*! Appends "value" to the window.  Returns "true" if the oldest value had to be evicted to make room. */
+  bool append( qreal value );
+
+  /*! Returns the number of values currently in the window. */
+  int size() const;
+
+  /*! Returns the value at position "i" in the window (0 is the oldest). */
+  qreal at( int i ) const;
+
+  /*! Returns the absolute sample index of the oldest value in the window. */
+  qint64 firstIndex() const;
+
+  /*! Returns the largest value in the window (0.0 if the window is empty). */
+  qreal maximum() const;
+
+private:
+  qreal valueAt( qint64 index ) const;
+
+  QVector< qreal >  m_values;       // circular, indexed by sample index modulo capacity
+  QVector< qint64 > m_maxDeque;     // circular, sample indices with strictly decreasing values
+  qint64            m_nextIndex;    // absolute index of the next sample to be appended
+  int               m_size;
+  int               m_dequeHead;
+  int               m_dequeSize;
+};
+
+#endif // GOBCHARTSSTREAMBUFFER_H
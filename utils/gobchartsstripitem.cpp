@@ -0,0 +1,137 @@
+/* Copyright (C) 2012 by William Hallatt.
+ *
+ * This file forms part of the "GobChartsWidget" library.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have downloaded a copy of the GNU General Public License
+ * (GNUGPL.txt) and GNU Lesser General Public License (GNULGPL.txt)
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * The official website for this project is www.goblincoding.com and,
+ * although not compulsory, it would be appreciated if all works of whatever
+ * nature referring to or using this library include a reference to this site.
+ */
+
+#include "gobchartsstripitem.h"
+
+#include <QtCore/qmath.h>
+#include <QPainter>
+
+/*--------------------------------------------------------------------------------*/
+
+const qreal STRIP_DOT_SIDE = 7;
+
+/*--------------------------------------------------------------------------------*/
+
+GobChartsStripItem::GobChartsStripItem( QGraphicsItem *parent ) :
+  QGraphicsItem( parent ),
+  m_pixmap     (),
+  m_rect       (),
+  m_residual   ( 0.0 )
+{
+}
+
+/*--------------------------------------------------------------------------------*/
+
+GobChartsStripItem::~GobChartsStripItem()
+{
+  // Default destructor
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsStripItem::setRect( const QRectF &rect )
+{
+  if( rect != m_rect )
+  {
+    prepareGeometryChange();
+    m_rect = rect;
+
+    QSize size( qMax( 1, qCeil( rect.width() ) ), qMax( 1, qCeil( rect.height() ) ) );
+
+    if( size != m_pixmap.size() )
+    {
+      m_pixmap = QPixmap( size );
+    }
+
+    clear();
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsStripItem::clear()
+{
+  m_pixmap.fill( Qt::transparent );
+  m_residual = 0.0;
+  update();
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsStripItem::drawPoint( const QPointF &previous, const QPointF &point, const QColor &colour )
+{
+  QPainter painter( &m_pixmap );
+  painter.setRenderHint( QPainter::Antialiasing );
+
+  painter.setPen( QPen( Qt::DotLine ) );
+  painter.drawLine( QLineF( previous, point ) );
+
+  painter.setPen( QPen( colour, 1 ) );
+  painter.setBrush( colour );
+  painter.drawEllipse( point, STRIP_DOT_SIDE/2, STRIP_DOT_SIDE/2 );
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsStripItem::scrollAndDraw( qreal dx, const QPointF &previous, const QPointF &point, const QColor &colour )
+{
+  m_residual += dx;
+  int shift   = qFloor( m_residual );
+  m_residual -= shift;
+
+  if( shift > 0 )
+  {
+    QRegion exposed;
+    m_pixmap.scroll( -shift, 0, m_pixmap.rect(), &exposed );
+
+    QPainter painter( &m_pixmap );
+    painter.setCompositionMode( QPainter::CompositionMode_Source );
+
+    foreach( const QRect &rect, exposed.rects() )
+    {
+      painter.fillRect( rect, Qt::transparent );
+    }
+  }
+
+  /* The pixmap lags behind the data by the residual, draw the new point accordingly. */
+  drawPoint( previous + QPointF( m_residual, 0 ), point + QPointF( m_residual, 0 ), colour );
+  update();
+}
+
+/*--------------------------------------------------------------------------------*/
+
+QRectF GobChartsStripItem::boundingRect() const
+{
+  return m_rect;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsStripItem::paint( QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget )
+{
+  Q_UNUSED( option );
+  Q_UNUSED( widget );
+  painter->drawPixmap( m_rect.topLeft(), m_pixmap );
+}
+
+/*--------------------------------------------------------------------------------*/
@@ -0,0 +1,77 @@
+/* Copyright (C) 2012 by William Hallatt.
+ *
+ * This file forms part of the "GobChartsWidget" library.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have downloaded a copy of the GNU General Public License
+ * (GNUGPL.txt) and GNU Lesser General Public License (GNULGPL.txt)
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * The official website for this project is www.goblincoding.com and,
+ * although not compulsory, it would be appreciated if all works of whatever
+ * nature referring to or using this library include a reference to this site.
+ */
+
+#ifndef GOBCHARTSSTRIPITEM_H
+#define GOBCHARTSSTRIPITEM_H
+
+#include <QGraphicsItem>
+#include <QPixmap>
+#include "utils/gobchartsnocopy.h"
+
+/// Pixmap-backed plot area for scrolling strip charts.
+
+/** GobChartsStripItem keeps the rasterised plot of a live line chart in a backing QPixmap.  Every new
+    sample scrolls the pixmap to the left (QPixmap::scroll) and only the newly exposed columns are drawn
+    into, which means that the cost of a tick is independent of the number of samples on display. \n
+
+    The pixmap is transparent so that the scene background shows through, grid lines, axes and labels
+    are separate scene items stacked above the strip. */
+class GobChartsStripItem : public QGraphicsItem,
+                           public GobChartsNoCopy
+{
+public:
+  //! Constructor.
+  explicit GobChartsStripItem( QGraphicsItem *parent = 0 );
+
+  //! Destructor.
+  ~GobChartsStripItem();
+
+  /*! Sets the scene rectangle covered by the strip.  The backing pixmap is resized and cleared
+      if the size changes. */
+  void setRect( const QRectF &rect );
+
+  /*! Clears the backing pixmap. */
+  void clear();
+
+  /*! Draws a data point at "point" and a line segment from "previous" to "point" into the backing pixmap
+      (pixmap coordinates) without scrolling. */
+  void drawPoint( const QPointF &previous, const QPointF &point, const QColor &colour );
+
+  /*! Scrolls the backing pixmap "dx" pixels to the left, clears the exposed columns and draws the
+      new data point (see drawPoint()).  Fractional scroll distances are accumulated so that the strip
+      does not drift from the data over time. */
+  void scrollAndDraw( qreal dx, const QPointF &previous, const QPointF &point, const QColor &colour );
+
+  /*! Re-implemented from QGraphicsItem.  See Qt API documentation for details. */
+  QRectF boundingRect() const;
+
+  /*! Re-implemented from QGraphicsItem.  See Qt API documentation for details. */
+  void paint( QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget = 0 );
+
+private:
+  QPixmap m_pixmap;
+  QRectF  m_rect;
+  qreal   m_residual;     // scroll distance not yet applied to the pixmap (less than a pixel)
+};
+
+#endif // GOBCHARTSSTRIPITEM_H
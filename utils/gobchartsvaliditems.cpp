@@ -23,9 +23,33 @@
 
 #include "gobchartsvaliditems.h"
 
+#include <algorithm>
+
+/*------------------------ NONMEMBER UTILITY FUNCTIONS ---------------------------*/
+
+namespace
+{
+  bool ValueLessThan( const QPair< qreal, int > &indexEntry, qreal value )
+  {
+    return indexEntry.first < value;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  bool ValueGreaterThan( qreal value, const QPair< qreal, int > &indexEntry )
+  {
+    return value < indexEntry.first;
+  }
+}
+
+
+/*------------------------------- MEMBER FUNCTIONS -------------------------------*/
+
 GobChartsValidItems::GobChartsValidItems( QObject *parent ) :
-  QObject   ( parent ),
-  m_validMap()
+  QObject          ( parent ),
+  m_validMap       (),
+  m_sortedIndex    (),
+  m_sortedIndexDirty( true )
 {
 }
 
@@ -44,6 +68,7 @@ void GobChartsValidItems::addValidItem( int row, QString category, qreal data )
   pair.first  = category;
   pair.second = data;
   m_validMap.insert( row, pair );
+  m_sortedIndexDirty = true;
 }
 
 /*--------------------------------------------------------------------------------*/
@@ -51,6 +76,8 @@ void GobChartsValidItems::addValidItem( int row, QString category, qreal data )
 void GobChartsValidItems::clear() 
 {
   m_validMap.clear();
+  m_sortedIndex.clear();
+  m_sortedIndexDirty = true;
 }
 
 /*--------------------------------------------------------------------------------*/
@@ -92,3 +119,71 @@ int GobChartsValidItems::size() const
 }
 
 /*--------------------------------------------------------------------------------*/
+
+QList< int > GobChartsValidItems::positionsWithinRange( qreal lower, qreal upper ) const
+{
+  QPair< int, int > bounds = rangeBounds( lower, upper );
+  QList< int > positions;
+
+  for( int i = bounds.first; i < bounds.second; i++ )
+  {
+    positions.append( m_sortedIndex.at( i ).second );
+  }
+
+  /* Callers draw in row order, not value order. */
+  std::sort( positions.begin(), positions.end() );
+  return positions;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+int GobChartsValidItems::nrItemsWithinRange( qreal lower, qreal upper ) const
+{
+  QPair< int, int > bounds = rangeBounds( lower, upper );
+  return bounds.second - bounds.first;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+QPair< int, int > GobChartsValidItems::rangeBounds( qreal lower, qreal upper ) const
+{
+  updateSortedIndex();
+
+  if( lower > upper )
+  {
+    return qMakePair( 0, 0 );
+  }
+
+  QVector< QPair< qreal, int > >::const_iterator first =
+      std::lower_bound( m_sortedIndex.constBegin(), m_sortedIndex.constEnd(), lower, ValueLessThan );
+
+  QVector< QPair< qreal, int > >::const_iterator last =
+      std::upper_bound( first, m_sortedIndex.constEnd(), upper, ValueGreaterThan );
+
+  return qMakePair( static_cast< int >( first - m_sortedIndex.constBegin() ),
+                    static_cast< int >( last  - m_sortedIndex.constBegin() ) );
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsValidItems::updateSortedIndex() const
+{
+  if( m_sortedIndexDirty )
+  {
+    m_sortedIndex.clear();
+    m_sortedIndex.reserve( m_validMap.size() );
+
+    int position( 0 );
+
+    for( QMultiMap< int, ItemPair >::const_iterator it = m_validMap.constBegin(); it != m_validMap.constEnd(); ++it )
+    {
+      m_sortedIndex.append( qMakePair( it.value().second, position ) );
+      position++;
+    }
+
+    std::sort( m_sortedIndex.begin(), m_sortedIndex.end() );
+    m_sortedIndexDirty = false;
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
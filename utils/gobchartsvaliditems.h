@@ -28,6 +28,7 @@
 #include <QObject>
 #include <QPair>
 #include <QMultiMap>
+#include <QVector>
 #include "utils/gobchartsnocopy.h"
 
 typedef QPair< QString, qreal > ItemPair;
@@ -35,7 +36,11 @@ typedef QPair< QString, qreal > ItemPair;
 /// Controls and manages valid model rows.
 
 /** GobChartsValidItems keeps track of which data rows and columns contain valid entries (non-empty, legal types, etc) 
-    and provides access to the valid values and category names based on the row number. */
+    and provides access to the valid values and category names based on the row number. \n
+
+    Alongside the row map, the class maintains a value-sorted index of all valid items so that data range
+    restrictions can be resolved with a binary search rather than by testing every item.  Throughout, an item's
+    "position" refers to its index within validRows(). */
 class GobChartsValidItems : public QObject,
                             public GobChartsNoCopy
 {
@@ -65,8 +70,30 @@ public:
   /*! Returns the number of valid items in the map. */
   int size() const;
 
+  /*! Returns the positions (indices into validRows()) of all items with values within [lower, upper], in
+      ascending order.  The k positions are found via a binary search over the value-sorted index and then sorted
+      into row order, i.e. O(log n + k log k).
+      \sa nrItemsWithinRange() */
+  QList< int > positionsWithinRange( qreal lower, qreal upper ) const;
+
+  /*! Returns the number of items with values within [lower, upper] in O(log n).
+      \sa positionsWithinRange() */
+  int nrItemsWithinRange( qreal lower, qreal upper ) const;
+
+  /*! Returns the first (inclusive) and last (exclusive) offsets into the value-sorted index that bound the
+      range [lower, upper].  Two ranges that produce the same bounds select exactly the same items, which
+      allows callers to skip redundant redraws. */
+  QPair< int, int > rangeBounds( qreal lower, qreal upper ) const;
+
 private:
+  /*! Rebuilds the value-sorted index if the valid items changed since it was last built. */
+  void updateSortedIndex() const;
+
   QMultiMap< int, ItemPair > m_validMap;
+
+  /* (value, position) pairs sorted by value, rebuilt lazily on the first range query after a change. */
+  mutable QVector< QPair< qreal, int > > m_sortedIndex;
+  mutable bool m_sortedIndexDirty;
 };
 
 #endif // GOBCHARTSVALIDITEMS_H
@@ -22,115 +22,72 @@
  */
 
 #include "gobchartsbarview.h"
-#include "utils/gobchartscolours.h"
+#include "utils/gobchartslayout.h"
 
 #include <QGraphicsDropShadowEffect>
 #include <QGraphicsRectItem>
+#include <QPainter>
 
 /*--------------------------------------------------------------------------------*/
 
-const int BAR_SPACING = 5;
+GobChartsBarView::GobChartsBarView( GobChartsView *view ) : 
+  GobChartsViewStrategy( view )
+{
+}
 
 /*--------------------------------------------------------------------------------*/
 
-GobChartsBarView::GobChartsBarView( QWidget *parent ) : 
-  GobChartsView( parent )
+GobChartsBarView::~GobChartsBarView()
 {
 }
 
 /*--------------------------------------------------------------------------------*/
 
-GobChartsBarView::~GobChartsBarView()
+QGraphicsItem *GobChartsBarView::createGraphicsItem( const GobChartsGeometryItem &geometryItem )
 {
+  QLinearGradient columnGradient( geometryItem.rect.bottomLeft(), geometryItem.rect.topRight() );
+  columnGradient.setColorAt( 0, QColor( ( Qt::GlobalColor ) 2 ) );
+  columnGradient.setColorAt( 1, geometryItem.colour );
+
+  /* Create bar item. */
+  QBrush columnBrush = ( renderQuality() == DRAFT_QUALITY ) ? QBrush( geometryItem.colour ) : QBrush( columnGradient );
+  QGraphicsRectItem *graphicsBar = new QGraphicsRectItem( geometryItem.rect );
+  graphicsBar->setBrush( columnBrush );
+
+  QGraphicsDropShadowEffect *dropShadow = new QGraphicsDropShadowEffect;
+  dropShadow->setOffset( QPointF( 2,-2 ) );         // two points to the top and right
+  dropShadow->setEnabled( renderQuality() == FULL_QUALITY );
+  graphicsBar->setGraphicsEffect( dropShadow );     // takes ownership
+
+  return graphicsBar;
 }
 
 /*--------------------------------------------------------------------------------*/
 
-void GobChartsBarView::generateGraphicsItems()
-{   
-  /* Add the chart columns. */
-  if( nrValidItems() > 0 )
-  {
-    emit clearLegend();
-
-    qreal barColWidth = gridWidth()/nrValidItems();
-    QList< int > validRows = validRowList();
-
-    for( int row = 0; row < nrValidItems(); row++)
-    {
-      QString cat = category( validRows.at( row ) );
-      qreal val   = value( validRows.at( row ) );
-
-      /* If the value doesn't fall within the specified data range, then ignore this particular category. */
-      if( !isWithinAllowedRange( val ) )
-      {
-        /* Increment colours so that the look of the chart doesn't change
-          when the user toggles between restricted and full ranges. */
-        GobChartsColours::getNextColour();
-        continue;
-      }
-
-      qreal dataPercentage = ( totalValue() > 0.0 ) ? ( val/totalValue() ) : 0.0;
-
-      /* Determine bar rectangle dimensions. */
-      QPointF topLeft;
-      QPointF bottomRight;
-
-      if( dataPercentage < 0.01 )
-      {
-        /* If we don't have at least a snippet of a graphics item, a lot of the selection model's functionality
-          doesn't work as well as it could.  Create at least the semblance of a bar if the value is zero. */
-        topLeft = QPointF( innerSceneRectF().left() + barColWidth * row,
-                           innerSceneRectF().bottom() - 1 /* pixel */ );
-
-        bottomRight = QPointF( innerSceneRectF().left() + barColWidth * row + barColWidth - BAR_SPACING,
-                               innerSceneRectF().bottom() );
-      }
-      else
-      {
-        topLeft = QPointF( innerSceneRectF().left() + barColWidth * row,
-                           innerSceneRectF().bottom() - stripSpace( dataPercentage ) - dataPercentage * innerSceneRectF().height() );
-
-        bottomRight = QPointF( innerSceneRectF().left() + barColWidth * row + barColWidth - BAR_SPACING,
-                               innerSceneRectF().bottom() );
-      }
-
-      QRectF barRectangle( topLeft, bottomRight );
-      QLinearGradient columnGradient( barRectangle.bottomLeft(), barRectangle.topRight() );
-      columnGradient.setColorAt( 0, QColor( ( Qt::GlobalColor ) 2 ) );
-
-      QColor colour;
-
-      if( useFixedColour() )
-      {
-        colour = fixedColour();
-        columnGradient.setColorAt( 1, colour );
-      }
-      else
-      {
-        colour = GobChartsColours::getNextColour();
-        columnGradient.setColorAt( 1, colour );
-      }
-
-      /* Create bar item and add to graph items container. */
-      QBrush columnBrush( columnGradient );
-      QGraphicsRectItem *graphicsBar = new QGraphicsRectItem( barRectangle );
-      graphicsBar->setBrush( columnBrush );
-
-      QGraphicsDropShadowEffect *dropShadow = new QGraphicsDropShadowEffect;
-      dropShadow->setOffset( QPointF( 2,-2 ) );         // two points to the top and right
-      graphicsBar->setGraphicsEffect( dropShadow );     // takes ownership
-
-      QString legendText = QString( "%1 - %2" ).arg( cat ).arg( val );
-      emit createLegendItem( colour, legendText );
-
-      addToGraphItemsContainer( model()->index( validRows.at( row ), VALUE ), graphicsBar, legendText );
-    }
-  }
-  else
+void GobChartsBarView::paintItem( QPainter *painter, const GobChartsGeometryItem &geometryItem ) const
+{
+  /* Shadow first, two points to the top and right (see createGraphicsItem). */
+  if( renderQuality() == FULL_QUALITY )
   {
-    debugLog( tr( "GobChartsBarView::generateGraphicsItems# No valid items." ) );
+    painter->setPen( Qt::NoPen );
+    painter->setBrush( QColor( 63, 63, 63, 180 ) );
+    painter->drawRect( geometryItem.rect.translated( 2, -2 ) );
   }
+
+  QLinearGradient columnGradient( geometryItem.rect.bottomLeft(), geometryItem.rect.topRight() );
+  columnGradient.setColorAt( 0, QColor( ( Qt::GlobalColor ) 2 ) );
+  columnGradient.setColorAt( 1, geometryItem.colour );
+
+  painter->setPen( QPen() );
+  painter->setBrush( ( renderQuality() == DRAFT_QUALITY ) ? QBrush( geometryItem.colour ) : QBrush( columnGradient ) );
+  painter->drawRect( geometryItem.rect );
+}
+
+/*--------------------------------------------------------------------------------*/
+
+GobChartsType GobChartsBarView::chartType() const
+{
+  return BAR;
 }
 
 /*--------------------------------------------------------------------------------*/
@@ -142,6 +99,13 @@ bool GobChartsBarView::needsGrid() const
 
 /*--------------------------------------------------------------------------------*/
 
+bool GobChartsBarView::supportsZoom() const
+{
+  return true;
+}
+
+/*--------------------------------------------------------------------------------*/
+
 QString GobChartsBarView::typeInteger() const
 {
   return QString( "%1" ).arg( static_cast< int >( BAR ) );
@@ -24,36 +24,46 @@
 #ifndef GOBCHARTSBARVIEW_H
 #define GOBCHARTSBARVIEW_H
 
-#include "gobchartsview.h"
+#include "gobchartsviewstrategy.h"
 
 /**  \ingroup ChartViews */
 
 /// Responsible for drawing BAR charts.
 
-/** This class implements the following GobChartsView pure virtual functions:
+/** This class implements the following GobChartsViewStrategy pure virtual functions:
 
-  -# generateGraphicsItems() 
+  -# createGraphicsItem() 
+  -# paintItem() 
+  -# chartType() 
   -# needsGrid() 
   -# typeInteger() 
 */
-class GobChartsBarView : public GobChartsView
+class GobChartsBarView : public GobChartsViewStrategy
 {
 public:
   //! Constructor.
-  GobChartsBarView( QWidget *parent = 0 );
+  explicit GobChartsBarView( GobChartsView *view );
 
   //! Destructor.
   virtual ~GobChartsBarView();
 
-protected:
   /*! Graphics (chart) items.
-      This function generates the chart's bar columns and uses the various categories' values
-      to determine each column's relative size with respect to each other and the confines of the available space. */ 
-  void generateGraphicsItems();
+      This function generates a single bar column.  The column's size relative to the other columns and
+      the confines of the available space is determined by GobChartsLayout. */ 
+  QGraphicsItem *createGraphicsItem( const GobChartsGeometryItem &geometryItem );
+
+  /*! Paints a single bar column (DIRECT_BACKEND).  The drop shadow is approximated by an offset rectangle. */
+  void paintItem( QPainter *painter, const GobChartsGeometryItem &geometryItem ) const;
+
+  /*! Chart type is BAR. */
+  GobChartsType chartType() const;
 
   /*! Grid required (returns "true"). */
   bool needsGrid() const;
 
+  /*! Zooming supported (returns "true"). */
+  bool supportsZoom() const;
+
   /*! Type integer is "0". */
   QString typeInteger()  const;
 };
@@ -51,16 +51,16 @@ GobChartsFactory::GobChartsFactory()
 
 /*--------------------------------------------------------------------------------*/
 
-GobChartsView *GobChartsFactory::createChart( GobChartsType type, QWidget *parent )
+GobChartsViewStrategy *GobChartsFactory::createStrategy( GobChartsType type, GobChartsView *view )
 {
   switch( type )
   {
   case BAR:
-    return new GobChartsBarView( parent );
+    return new GobChartsBarView( view );
   case PIE:
-    return new GobChartsPieView( parent );
+    return new GobChartsPieView( view );
   case LINE:
-    return new GobChartsLineView( parent );
+    return new GobChartsLineView( view );
   }
 
   return NULLPOINTER;
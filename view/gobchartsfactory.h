@@ -28,23 +28,22 @@
 #include "utils/gobchartsnocopy.h"
 
 class GobChartsView;
-class QWidget;
+class GobChartsViewStrategy;
 
-/// Factory class responsible for the creation of charts at run-time.
+/// Factory class responsible for the creation of chart type strategies at run-time.
 
-/** This factory is implemented as a singleton and is responsible for the creation of the user-selected
-    chart types at run-time.  Care must be taken when using this factory as it does not maintain
-    ownership of the chart views it creates and clean-up becomes the responsibility of the calling object
-    when no parent is specified. */
+/** This factory is implemented as a singleton and is responsible for the creation of the strategies
+    implementing the user-selected chart types at run-time.  The factory does not maintain ownership
+    of the strategies it creates, clean-up is the responsibility of the calling object (GobChartsView). */
 class GobChartsFactory : GobChartsNoCopy
 {
 public:
   /*! Returns the singleton instance. */
   static GobChartsFactory *getInstance();
 
-  /*! Creates a chart view of type "type".  If no parent is provided, clean-up becomes the responsibility
+  /*! Creates the strategy for charts of type "type" drawn by "view".  Clean-up is the responsibility
       of the calling object. */
-  GobChartsView *createChart( GobChartsType type, QWidget *parent );
+  GobChartsViewStrategy *createStrategy( GobChartsType type, GobChartsView *view );
 
 private:
   /*! Private constructor. */
@@ -22,19 +22,214 @@
  */
 
 #include "gobchartslineview.h"
+#include "utils/gobchartslayout.h"
 #include "utils/gobchartscolours.h"
+#include "utils/gobchartsstreambuffer.h"
+#include "utils/gobchartsstripitem.h"
 
 #include <QGraphicsEllipseItem>
+#include <QGraphicsScene>
+#include <QQueue>
+#include <QPainter>
 #include <QPen>
 
 /*--------------------------------------------------------------------------------*/
 
-const qreal DOT_SIDE = 7;
+const qreal DOT_SIDE         = 7;
+const qreal STREAM_HEADROOM  = 0.05;    // fraction of the inner height left free above the window maximum
 
 /*--------------------------------------------------------------------------------*/
 
-GobChartsLineView::GobChartsLineView( QWidget *parent ) :
-  GobChartsView( parent )
+/* A streamed data point and the line segment leading up to it. */
+struct StreamPoint
+{
+  QGraphicsEllipseItem *dot;
+  QGraphicsLineItem    *segment;
+};
+
+
+/*--------------------------------- PIMPL CLASS ----------------------------------*/
+
+struct GobChartsLineView::GobChartsLineViewPrivate
+{
+  /* Constructor and destructor. */
+  GobChartsLineViewPrivate( GobChartsLineView *view ) :
+    m_lineView   ( view ),
+    m_buffer     (),
+    m_points     (),
+    m_clipItem   ( new QGraphicsRectItem ),
+    m_contentItem( new QGraphicsRectItem( m_clipItem ) ),
+    m_stripItem  ( new GobChartsStripItem ),
+    m_innerRect  (),
+    m_spacing    ( 0.0 ),
+    m_scaleMax   ( 0.0 ),
+    m_origin     ( 0 ),
+    m_mode       ( STREAM_ITEMS ),
+    m_streaming  ( false )
+  {
+    /* Points sliding out of the inner rectangle are clipped rather than drawn over the labels. */
+    m_clipItem->setPen( Qt::NoPen );
+    m_clipItem->setFlag( QGraphicsItem::ItemClipsChildrenToShape );
+    m_contentItem->setPen( Qt::NoPen );
+
+    /* Grid lines, axes and labels are drawn on top of the strip. */
+    m_stripItem->setZValue( -1 );
+  }
+
+  ~GobChartsLineViewPrivate()
+  {
+    removeStreamLayer();
+    delete m_clipItem;    // deletes all points
+    delete m_stripItem;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Returns the item containing the streamed data for the current mode. */
+  QGraphicsItem *streamLayer() const
+  {
+    return ( m_mode == STREAM_STRIP ) ? static_cast< QGraphicsItem* >( m_stripItem )
+                                      : static_cast< QGraphicsItem* >( m_clipItem );
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  void removeStreamLayer()
+  {
+    if( streamLayer()->scene() )
+    {
+      streamLayer()->scene()->removeItem( streamLayer() );
+    }
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  void deletePoints()
+  {
+    while( !m_points.isEmpty() )
+    {
+      delete m_points.dequeue().dot;    // deletes segment
+    }
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Returns the y coordinate of "value" relative to the bottom of the inner rectangle. */
+  qreal valueY( qreal value ) const
+  {
+    return ( m_scaleMax > 0.0 ) ? -( value/m_scaleMax ) * m_innerRect.height() * ( 1.0 - STREAM_HEADROOM ) : 0.0;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Returns the position of sample "index" (absolute) in content item coordinates. */
+  QPointF pointFor( qint64 index, qreal value ) const
+  {
+    return QPointF( ( index - m_origin ) * m_spacing, valueY( value ) );
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Returns the position of window position "i" in strip (pixmap) coordinates, the newest sample
+    is always at the right-hand edge. */
+  QPointF stripPointFor( int i, qreal value ) const
+  {
+    return QPointF( m_innerRect.width() - m_spacing/2 - ( m_buffer.size() - 1 - i ) * m_spacing,
+                    m_innerRect.height() + valueY( value ) );
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  QColor colourFor( qint64 index ) const
+  {
+    /* The colours repeat anyway, reduce the index (by a whole number of sequences) before it can overflow an "int". */
+    return m_lineView->useFixedColour() ? m_lineView->fixedColour()
+                                        : GobChartsColours::colourAt( static_cast< int >( index % GobChartsColours::colourCount() ) );
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  void positionPoint( const StreamPoint &point, qint64 index, qreal value, const QPointF &previous )
+  {
+    QPointF p = pointFor( index, value );
+    QColor colour = colourFor( index );
+
+    point.dot->setRect( p.x() - DOT_SIDE/2, p.y() - DOT_SIDE/2, DOT_SIDE, DOT_SIDE );
+    point.dot->setPen( QPen( colour, 1 ) );
+    point.dot->setBrush( colour );
+    point.dot->setZValue( -static_cast< qreal >( index - m_origin ) );
+    point.segment->setLine( QLineF( previous, p ) );
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Slides the content so that the oldest sample sits at the left of the inner rectangle. */
+  void shiftContent()
+  {
+    m_contentItem->setPos( m_innerRect.left() + m_spacing/2 - ( m_buffer.firstIndex() - m_origin ) * m_spacing,
+                           m_innerRect.bottom() );
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Repositions every point, this is only required when the geometry or the window maximum changes. */
+  void relayout()
+  {
+    m_innerRect = m_lineView->innerSceneRectF();
+    m_spacing   = m_innerRect.width()/m_buffer.capacity();
+    m_scaleMax  = m_buffer.maximum();
+    m_origin    = m_buffer.firstIndex();    // keeps coordinates small however long the stream runs
+
+    if( m_mode == STREAM_STRIP )
+    {
+      /* Re-rasterise the entire window. */
+      m_stripItem->setRect( m_innerRect );
+      m_stripItem->clear();
+
+      for( int i = 0; i < m_buffer.size(); i++ )
+      {
+        QPointF p = stripPointFor( i, m_buffer.at( i ) );
+        m_stripItem->drawPoint( ( i > 0 ) ? stripPointFor( i - 1, m_buffer.at( i - 1 ) ) : p, p,
+                                colourFor( m_buffer.firstIndex() + i ) );
+      }
+
+      return;
+    }
+
+    m_clipItem->setRect( m_innerRect );
+
+    qint64  index    = m_buffer.firstIndex();
+    QPointF previous = pointFor( index, m_buffer.size() > 0 ? m_buffer.at( 0 ) : 0.0 );
+
+    for( int i = 0; i < m_points.size(); i++, index++ )
+    {
+      positionPoint( m_points.at( i ), index, m_buffer.at( i ), previous );
+      previous = pointFor( index, m_buffer.at( i ) );
+    }
+
+    shiftContent();
+  }
+
+  GobChartsLineView     *m_lineView;
+  GobChartsStreamBuffer  m_buffer;
+  QQueue< StreamPoint >  m_points;        // oldest first, one per sample in m_buffer
+  QGraphicsRectItem     *m_clipItem;
+  QGraphicsRectItem     *m_contentItem;   // parent of all points, moved to slide the window
+  GobChartsStripItem    *m_stripItem;
+  QRectF                 m_innerRect;     // inner scene rectangle the points were laid out for
+  qreal                  m_spacing;
+  qreal                  m_scaleMax;      // the window maximum the y coordinates are currently scaled to
+  qint64                 m_origin;        // sample index at content x == 0
+  GobChartsStreamMode    m_mode;
+  bool                   m_streaming;
+};
+
+
+/*------------------------------- MEMBER FUNCTIONS -------------------------------*/
+
+GobChartsLineView::GobChartsLineView( GobChartsView *view ) :
+  GobChartsViewStrategy( view ),
+  m_lineViewPrivate( new GobChartsLineViewPrivate( this ) )
 {
 }
 
@@ -43,82 +238,164 @@ GobChartsLineView::GobChartsLineView( QWidget *parent ) :
 
 GobChartsLineView::~GobChartsLineView() 
 {
-  // Default destructor
+  delete m_lineViewPrivate;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsLineView::setStreamingWindow( int windowSize, GobChartsStreamMode mode )
+{
+  m_lineViewPrivate->deletePoints();
+  m_lineViewPrivate->removeStreamLayer();
+  m_lineViewPrivate->m_streaming = ( windowSize > 0 );
+  m_lineViewPrivate->m_mode      = mode;
+
+  if( m_lineViewPrivate->m_streaming )
+  {
+    m_lineViewPrivate->m_buffer.setCapacity( windowSize );
+    chartScene()->addItem( m_lineViewPrivate->streamLayer() );
+  }
+  else
+  {
+    m_lineViewPrivate->m_buffer.clear();
+  }
+
+  drawChart();
 }
 
 /*--------------------------------------------------------------------------------*/
 
-void GobChartsLineView::generateGraphicsItems()
+void GobChartsLineView::appendStreamSample( qreal value )
 {
-  if( nrValidItems() > 0 )
+  if( !m_lineViewPrivate->m_streaming )
   {
-    emit clearLegend();
+    debugLog( tr( "GobChartsLineView::appendStreamSample# Streaming mode is \"off\"." ) );
+    return;
+  }
 
-    qreal pointSpacing = gridWidth()/nrValidItems();
-    qreal previousX    = innerSceneRectF().left();
-    qreal nextX        = innerSceneRectF().left();
-    qreal previousY    = innerSceneRectF().bottom();
-    qreal nextY        = innerSceneRectF().bottom();
+  GobChartsLineViewPrivate *d = m_lineViewPrivate;
+  value = qMax( value, 0.0 );
 
-    QList< int > activeRows = validRowList();
+  if( d->m_mode == STREAM_STRIP )
+  {
+    d->m_buffer.append( value );
 
-    for( int row = 0; row < nrValidItems(); row++ )
+    if( d->m_buffer.maximum() != d->m_scaleMax || d->m_innerRect != innerSceneRectF() )
+    {
+      d->relayout();
+    }
+    else
     {
-      QString cat = category( activeRows.at( row ) );
-      qreal val   = value( activeRows.at( row ) );
+      int last = d->m_buffer.size() - 1;
+      QPointF point = d->stripPointFor( last, value );
+      QPointF previous = ( last > 0 ) ? d->stripPointFor( last - 1, d->m_buffer.at( last - 1 ) ) : point;
 
-      /* If the value doesn't fall within the specified data range, then ignore this particular category. */
-      if( !isWithinAllowedRange( val ) )
-      {
-        /* Increment colours so that the look of the chart doesn't change
-          when the user toggles between restricted and full ranges. */
-        GobChartsColours::getNextColour();
-        continue;
-      }
+      /* "previous" is where the last sample will be once the strip has scrolled. */
+      d->m_stripItem->scrollAndDraw( d->m_spacing, previous, point, d->colourFor( d->m_buffer.firstIndex() + last ) );
+    }
 
-      qreal dataPercentage = ( totalValue() > 0.0 ) ? ( val/totalValue() ) : 0.0;
+    return;
+  }
 
-      nextX = innerSceneRectF().left() + pointSpacing * row + pointSpacing/2;
-      nextY = ( innerSceneRectF().bottom() - stripSpace( dataPercentage ) ) - innerSceneRectF().height() * dataPercentage;
+  StreamPoint point;
 
-      /* Create dot. */
-      QGraphicsEllipseItem *dot = new QGraphicsEllipseItem( nextX - DOT_SIDE/2, nextY - DOT_SIDE/2, DOT_SIDE, DOT_SIDE);
+  /* Recycle the evicted sample's items rather than creating new ones. */
+  if( d->m_buffer.append( value ) )
+  {
+    point = d->m_points.dequeue();
+  }
+  else
+  {
+    point.dot     = new QGraphicsEllipseItem( d->m_contentItem );
+    point.segment = new QGraphicsLineItem( point.dot );
+    point.segment->setPen( QPen( Qt::DotLine ) );
+    point.segment->setFlag( QGraphicsItem::ItemStacksBehindParent );
+  }
 
-      QColor colour;
+  d->m_points.enqueue( point );
 
-      if( useFixedColour() )
-      {
-        colour = fixedColour();
-        dot->setPen( QPen( colour, 1 ) );
-        dot->setBrush( colour );
-      }
-      else
-      {
-        colour = GobChartsColours::getNextColour();
-        dot->setPen( QPen( colour, 1 ) );
-        dot->setBrush( colour );
-      }
+  if( d->m_buffer.maximum() != d->m_scaleMax || d->m_innerRect != innerSceneRectF() )
+  {
+    d->relayout();
+  }
+  else
+  {
+    qint64 index = d->m_buffer.firstIndex() + d->m_buffer.size() - 1;
+    QPointF previous = ( d->m_buffer.size() > 1 ) ? d->pointFor( index - 1, d->m_buffer.at( d->m_buffer.size() - 2 ) )
+                                                  : d->pointFor( index, value );
+    d->positionPoint( point, index, value, previous );
+    d->shiftContent();
+  }
+}
 
-      dot->setZValue( nrValidItems() - row );
+/*--------------------------------------------------------------------------------*/
 
-      /* Create line. */
-      QGraphicsLineItem *lineItem = new QGraphicsLineItem( previousX, previousY, nextX, nextY, dot );
-      lineItem->setPen( QPen( Qt::DotLine ) );
-      lineItem->setFlag( QGraphicsItem::ItemStacksBehindParent );
+bool GobChartsLineView::isStreaming() const
+{
+  return m_lineViewPrivate->m_streaming;
+}
 
-      QString legendText = QString( "%1 - %2" ).arg( cat ).arg( val );
-      emit createLegendItem( colour, legendText );
+/*--------------------------------------------------------------------------------*/
 
-      addToGraphItemsContainer( model()->index( activeRows.at( row ),VALUE ), dot, legendText );
+void GobChartsLineView::relayoutStream()
+{
+  m_lineViewPrivate->relayout();
+}
 
-      previousX = nextX;
-      previousY = nextY;
-    }
+/*--------------------------------------------------------------------------------*/
+
+QGraphicsItem *GobChartsLineView::createGraphicsItem( const GobChartsGeometryItem &geometryItem )
+{
+  const QPointF &point = geometryItem.point;
+
+  /* Create dot. */
+  QGraphicsEllipseItem *dot = new QGraphicsEllipseItem( point.x() - DOT_SIDE/2, point.y() - DOT_SIDE/2, DOT_SIDE, DOT_SIDE );
+  dot->setPen( QPen( geometryItem.colour, 1 ) );
+  dot->setBrush( geometryItem.colour );
+  dot->setZValue( nrValidItems() - geometryItem.position );
+
+  /* Create line. */
+  QGraphicsLineItem *lineItem = new QGraphicsLineItem( QLineF( geometryItem.previousPoint, point ), dot );
+  lineItem->setPen( QPen( Qt::DotLine ) );
+  lineItem->setFlag( QGraphicsItem::ItemStacksBehindParent );
+
+  /* Aggregated (pyramid bucket) points also show the range of the values they summarise. */
+  if( !geometryItem.span.isNull() )
+  {
+    QGraphicsLineItem *spanItem = new QGraphicsLineItem( geometryItem.span, dot );
+    spanItem->setPen( QPen( geometryItem.colour, 1 ) );
+    spanItem->setFlag( QGraphicsItem::ItemStacksBehindParent );
   }
-  else
+
+  return dot;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsLineView::paintItem( QPainter *painter, const GobChartsGeometryItem &geometryItem ) const
+{
+  const QPointF &point = geometryItem.point;
+
+  /* Line first, it stacks behind the dot (see createGraphicsItem). */
+  painter->setPen( QPen( Qt::DotLine ) );
+  painter->drawLine( QLineF( geometryItem.previousPoint, point ) );
+
+  painter->setPen( QPen( geometryItem.colour, 1 ) );
+
+  if( !geometryItem.span.isNull() )
   {
-    debugLog( tr( "GobChartsLineView::generateGraphicsItems# No valid items." ) );
+    painter->drawLine( geometryItem.span );
   }
+
+  painter->setBrush( geometryItem.colour );
+  painter->drawEllipse( QRectF( point.x() - DOT_SIDE/2, point.y() - DOT_SIDE/2, DOT_SIDE, DOT_SIDE ) );
+}
+
+/*--------------------------------------------------------------------------------*/
+
+GobChartsType GobChartsLineView::chartType() const
+{
+  return LINE;
 }
 
 /*--------------------------------------------------------------------------------*/
@@ -130,6 +407,13 @@ bool GobChartsLineView::needsGrid() const
 
 /*--------------------------------------------------------------------------------*/
 
+bool GobChartsLineView::supportsZoom() const
+{
+  return true;
+}
+
+/*--------------------------------------------------------------------------------*/
+
 QString GobChartsLineView::typeInteger() const
 {
   return QString( "%1" ).arg( static_cast< int >( LINE ) );
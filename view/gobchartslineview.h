@@ -24,38 +24,77 @@
 #ifndef GOBCHARTSLINEVIEW_H
 #define GOBCHARTSLINEVIEW_H
 
-#include "gobchartsview.h"
+#include "gobchartsviewstrategy.h"
 
 /**  \ingroup ChartViews */
 
 /// Responsible for drawing LINE charts.
 
-/** This class implements the following GobChartsView pure virtual functions:
+/** This class implements the following GobChartsViewStrategy pure virtual functions:
 
-  -# generateGraphicsItems() 
+  -# createGraphicsItem() 
+  -# paintItem() 
+  -# chartType() 
   -# needsGrid() 
   -# typeInteger() 
+
+    GobChartsLineView furthermore supports a streaming mode (see setStreamingWindow()) in which the chart shows
+    a sliding window over the last N samples appended to it rather than the model's data.  Appending a sample
+    only positions one point and one line segment and shifts the existing ones, the remaining points are
+    only rescaled when the maximum value within the window changes. 
+
+
+    For live charts with long windows, the STREAM_STRIP mode rasterises the plot into a pixmap instead
+    (see GobChartsStripItem) which is scrolled by one sample per tick so that only the new sample is drawn.
 */
-class GobChartsLineView : public GobChartsView
+class GobChartsLineView : public GobChartsViewStrategy
 {
 public:
   //! Constructor.
-  GobChartsLineView( QWidget *parent = 0 );
+  explicit GobChartsLineView( GobChartsView *view );
 
   //! Destructor.
   virtual ~GobChartsLineView();
 
-protected:
+  /*! Turns streaming mode "on" for a window of "windowSize" samples (0 turns it "off").  Any samples
+      streamed previously are discarded.
+      \sa appendStreamSample() */
+  void setStreamingWindow( int windowSize, GobChartsStreamMode mode = STREAM_ITEMS );
+
+  /*! Appends "value" to the streaming window, evicting the oldest sample if the window is full.
+      Negative values are rounded up to zero.
+      \sa setStreamingWindow() */
+  void appendStreamSample( qreal value );
+
   /*! Graphics (chart) items.
-      This function generates the chart's line segments and uses the various categories' values
-      to determine each segment's relative size with respect to each other and the confines of the available space. */ 
-  void generateGraphicsItems();
+      This function generates a single data point and the line segment leading up to it.  The positions
+      relative to the other points and the confines of the available space are determined by GobChartsLayout. */ 
+  QGraphicsItem *createGraphicsItem( const GobChartsGeometryItem &geometryItem );
+
+  /*! Paints a single data point and the line segment leading up to it (DIRECT_BACKEND). */
+  void paintItem( QPainter *painter, const GobChartsGeometryItem &geometryItem ) const;
+
+  /*! Chart type is LINE. */
+  GobChartsType chartType() const;
 
   /*! Grid required (returns "true"). */
   bool needsGrid() const;
 
+  /*! Zooming supported (returns "true"). */
+  bool supportsZoom() const;
+
   /*! Type integer is "2". */
   QString typeInteger()  const;
+
+  /*! Returns "true" while in streaming mode. */
+  bool isStreaming() const;
+
+  /*! Repositions and rescales all streamed points. */
+  void relayoutStream();
+
+private:
+  struct GobChartsLineViewPrivate;
+  GobChartsLineViewPrivate *m_lineViewPrivate;
 };
 
 #endif // GOBCHARTSLINEVIEW_H
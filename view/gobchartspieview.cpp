@@ -22,16 +22,17 @@
  */
 
 #include "gobchartspieview.h"
-#include "utils/gobchartscolours.h"
+#include "utils/gobchartslayout.h"
 #include "utils/globalincludes.h"
 
 #include <QGraphicsDropShadowEffect>
 #include <QGraphicsEllipseItem>
+#include <QPainter>
 
 /*--------------------------------------------------------------------------------*/
 
-GobChartsPieView::GobChartsPieView( QWidget *parent ) :
-  GobChartsView( parent )
+GobChartsPieView::GobChartsPieView( GobChartsView *view ) :
+  GobChartsViewStrategy( view )
 {
 }
 
@@ -44,70 +45,31 @@ GobChartsPieView::~GobChartsPieView()
 
 /*--------------------------------------------------------------------------------*/
 
-void GobChartsPieView::generateGraphicsItems()
+QGraphicsItem *GobChartsPieView::createGraphicsItem( const GobChartsGeometryItem &geometryItem )
 {
-  if( nrValidItems() > 0 )
-  {
-    emit clearLegend();
-
-    /* Calculate pie positioning specs. */
-    qreal pieWidth  = gridWidth();
-    qreal pieHeight = innerSceneRectF().height();
-    QRectF pieRectangle( innerSceneRectF().left(), innerSceneRectF().top(), pieWidth, pieHeight );
-
-    /* Add pie segments. */
-    qreal fullElipse  = 5760;     // span angles in 16th of a degree (360*16)
-    int lastStopAngle = 0;
-
-    QList< int > activeRows = validRowList();
-
-    for( int row = 0; row < nrValidItems(); row++ )
-    {
-      QString cat = category( activeRows.at( row ) );
-      qreal val   = value( activeRows.at( row ) );
-
-      /* If the value doesn't fall within the specified data range, then ignore this particular category. */
-      if( !isWithinAllowedRange( val ) )
-      {
-        /* Increment colours so that the look of the chart doesn't change
-          when the user toggles between restricted and full ranges. */
-        GobChartsColours::getNextColour();
-        continue;
-      }
-
-      qreal dataPercentage = ( totalValue() > 0.0 ) ? ( val/totalValue()) : 0.0;
-
-      /* Draw ellipse. */
-      QGraphicsEllipseItem *graphSegment = new QGraphicsEllipseItem( pieRectangle );
-
-      QColor colour;
-
-      if( useFixedColour() )
-      {
-        colour = fixedColour();
-        graphSegment->setBrush( colour );
-      }
-      else
-      {
-        colour = GobChartsColours::getNextColour();
-        graphSegment->setBrush( colour );
-      }
-
-      graphSegment->setStartAngle( lastStopAngle );
-      graphSegment->setSpanAngle( qRound( dataPercentage * fullElipse ) );
-
-      QString legendText = QString( "%1 - %2" ).arg( cat ).arg( val );
-      emit createLegendItem( colour, legendText );
-
-      addToGraphItemsContainer( model()->index( activeRows.at( row ), VALUE ), graphSegment, legendText );
-
-      lastStopAngle += graphSegment->spanAngle();
-    }
-  }
-  else
-  {
-    debugLog( tr( "GobChartsPieView::generateGraphicsItems# No valid items." ) );
-  }
+  /* Draw ellipse. */
+  QGraphicsEllipseItem *graphSegment = new QGraphicsEllipseItem( geometryItem.rect );
+  graphSegment->setBrush( geometryItem.colour );
+  graphSegment->setStartAngle( geometryItem.startAngle );
+  graphSegment->setSpanAngle( geometryItem.spanAngle );
+
+  return graphSegment;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsPieView::paintItem( QPainter *painter, const GobChartsGeometryItem &geometryItem ) const
+{
+  painter->setPen( QPen() );
+  painter->setBrush( geometryItem.colour );
+  painter->drawPie( geometryItem.rect, geometryItem.startAngle, geometryItem.spanAngle );
+}
+
+/*--------------------------------------------------------------------------------*/
+
+GobChartsType GobChartsPieView::chartType() const
+{
+  return PIE;
 }
 
 /*--------------------------------------------------------------------------------*/
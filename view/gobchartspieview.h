@@ -24,32 +24,39 @@
 #ifndef GOBCHARTSPIEVIEW_H
 #define GOBCHARTSPIEVIEW_H
 
-#include "gobchartsview.h"
+#include "gobchartsviewstrategy.h"
 
 /**  \ingroup ChartViews */
 
 /// Responsible for drawing PIE charts.
 
-/** This class implements the following GobChartsView pure virtual functions:
+/** This class implements the following GobChartsViewStrategy pure virtual functions:
 
-  -# generateGraphicsItems() 
+  -# createGraphicsItem() 
+  -# paintItem() 
+  -# chartType() 
   -# needsGrid() 
   -# typeInteger() 
 */
-class GobChartsPieView : public GobChartsView
+class GobChartsPieView : public GobChartsViewStrategy
 {
 public:
   //! Constructor.
-  GobChartsPieView( QWidget *parent = 0 );
+  explicit GobChartsPieView( GobChartsView *view );
 
   //! Destructor.
   virtual ~GobChartsPieView();
 
-protected:
   /*! Graphics (chart) items.
-      This function generates the chart's pie segments and uses the various categories' values
-      to determine each segment's relative size with respect to each other and the confines of the available space. */ 
-  void generateGraphicsItems();
+      This function generates a single pie segment.  The segment's angles relative to the other segments
+      are determined by GobChartsLayout. */ 
+  QGraphicsItem *createGraphicsItem( const GobChartsGeometryItem &geometryItem );
+
+  /*! Paints a single pie segment (DIRECT_BACKEND). */
+  void paintItem( QPainter *painter, const GobChartsGeometryItem &geometryItem ) const;
+
+  /*! Chart type is PIE. */
+  GobChartsType chartType() const;
 
   /*! No grid required (returns "false"). */
   bool needsGrid() const;
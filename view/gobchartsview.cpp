@@ -22,16 +22,39 @@
  */
 
 #include "gobchartsview.h"
+#include "gobchartsfactory.h"
+#include "gobchartsviewstrategy.h"
 #include "label/gobchartstextitem.h"
-#include "utils/gobchartscolours.h"
 #include "utils/gobchartsgrid.h"
 #include "utils/gobchartsgraphitems.h"
 #include "utils/gobchartsvaliditems.h"
+#include "utils/gobchartslayout.h"
+#include "utils/gobchartsingestionqueue.h"
+#include "utils/gobchartsframeclock.h"
+#include "utils/gobchartshibernation.h"
 
 #include <QtCore/qmath.h>
+#include <QAbstractTextDocumentLayout>
+#include <QElapsedTimer>
+#include <QPainter>
+#include <QTextDocument>
+#include <QtConcurrentRun>
+#include <QFutureWatcher>
+#include <QMap>
+#include <QHash>
+#include <QGraphicsPathItem>
+#include <QGraphicsRectItem>
+#include <QApplication>
+#include <QMouseEvent>
+#include <QRubberBand>
+#include <QToolTip>
+#include <QScrollBar>
+#include <QWheelEvent>
 #include <QGraphicsView>
+#include <QTimer>
 #include <QVBoxLayout>
 #include <QDomDocument>
+#include <algorithm>
 
 /*--------------------------------------------------------------------------------*/
 
@@ -52,14 +75,84 @@ const qreal PERC_YLABEL_LEFT       = 0.2;   // from left-hand side of the scene
 const qreal LEFT_RIGHT_MARGIN_PERC = 0.15;  // of total width
 const qreal TOP_BOTTOM_MARGIN_PERC = 0.15;  // of total height
 
-/* Arbitrary number selected on the basis of the resulting cosmetic appearance. */
-const qreal STRIPSPACE_OFFSET      = 0.05;
+const qreal STANDARD_DPI           = 96.0;  // logical dots per inch of a standard resolution display
 
+const int   BUDGET_CHECK_STEP      = 64;    // number of items created between frame budget checks
+
+/* Selected items are highlighted the same way GobChartsGraphItems highlights them. */
+const qreal SELECTED_OPACITY       = 0.65;
+
+/* Progressive rendering. */
+const int   PROGRESSIVE_THRESHOLD  = 5000;  // minimum number of items before the chart is built progressively
+const qreal PREVIEW_BUCKET_WIDTH   = 2.0;   // width (in scene coordinates) of a single preview bucket
+
+const int   LABEL_SYNC_DELAY       = 300;   // milliseconds without label keystrokes before the label details are broadcast
+
+const int   RANGE_OVERLAY_ALPHA    = 60;
+const qreal RANGE_OVERLAY_Z        = 1000.0;  // above all chart items
+const qreal RANGE_POINT_MARGIN     = 3.0;     // extent of a LINE data point within the range overlay
+
+const int   HOVER_INTERVAL         = 16;      // milliseconds between hover hit tests (roughly one display refresh)
+const qreal HOVER_POINT_RADIUS     = 5.0;     // radius of the outline around a hovered LINE data point
+const qreal HOVER_OUTLINE_Z        = 1001.0;  // above the range overlay
+
+const qreal ZOOM_STEP              = 1.25;    // zoom factor per mouse wheel notch
+const int   MIN_ZOOM_SPAN          = 2;       // minimum number of positions in a zoomed range
+
+const int   ITEM_MEMORY_ESTIMATE   = 400;     // bytes per chart graphics item (item, effects and scene index entries)
+const int   LEGEND_TEXT_ESTIMATE   = 24;      // characters per legend text, for estimating layout sizes up front
+
+
+/*------------------------ NONMEMBER UTILITY FUNCTIONS ---------------------------*/
+
+/* Calculates the geometry of the same snapshot for each of "types" (runs on a worker thread). */
+QList< GobChartsGeometry > CalculateAlternateLayouts( const QList< GobChartsType > &types,
+                                                      const GobChartsDataSnapshot &snapshot,
+                                                      const QRectF &innerRect,
+                                                      QAtomicInt *latestVersion )
+{
+  QList< GobChartsGeometry > geometries;
+
+  foreach( GobChartsType type, types )
+  {
+    geometries.append( GobChartsLayout::calculate( type, snapshot, innerRect, latestVersion ) );
+
+    if( geometries.last().cancelled )
+    {
+      break;
+    }
+  }
+
+  return geometries;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+/* Returns the (approximate) number of bytes a geometry of "count" items will take up, before it is calculated. */
+qint64 EstimatedGeometryMemory( int count )
+{
+  return sizeof( GobChartsGeometry ) + count * ( sizeof( GobChartsGeometryItem ) + LEGEND_TEXT_ESTIMATE * sizeof( QChar ) );
+}
+
+/*--------------------------------------------------------------------------------*/
+
+/* Returns the (approximate) number of bytes taken up by "geometry". */
+qint64 GeometryMemory( const GobChartsGeometry &geometry )
+{
+  qint64 bytes = sizeof( GobChartsGeometry ) + geometry.items.capacity() * sizeof( GobChartsGeometryItem );
+
+  foreach( const GobChartsGeometryItem &item, geometry.items )
+  {
+    bytes += item.legendText.capacity() * sizeof( QChar );
+  }
+
+  return bytes;
+}
 
 
 /*--------------------------------- PIMPL CLASS ----------------------------------*/
 
-class GobChartsView::GobChartsViewPrivate
+class GobChartsView::GobChartsViewPrivate : public GobChartsHibernatable
 {
 public:
 
@@ -81,6 +174,9 @@ public:
     m_maxValue   = 0.0;
     m_maxRow     = 0;
     m_validItems->clear();
+    m_visibleBounds = qMakePair( -1, -1 );
+    m_visibleDirty  = true;
+    m_snapshotDirty = true;
 
     bool toDoubleOK = true;
 
@@ -135,338 +231,2296 @@ public:
 
   /*--------------------------------------------------------------------------------*/
 
-  /* Calculates and sets all the chart's dimensions and allowed areas. */
-  void calculateGeometries()
+  /* Returns an up to date snapshot of the data and the settings relevant to the layout.  The (potentially
+    large) data arrays are only rebuilt when the valid items changed, every call results in a new version. */
+  const GobChartsDataSnapshot &dataSnapshot()
   {
-    m_leftRightMargin = m_gobChartsView->rect().width()  * LEFT_RIGHT_MARGIN_PERC;
-    m_topBottomMargin = m_gobChartsView->rect().height() * TOP_BOTTOM_MARGIN_PERC;
+    if( m_snapshotDirty )
+    {
+      QList< int > rows = m_validItems->validRows();
 
-    m_graphScene->setSceneRect( QRectF( m_gobChartsView->rect() ) );
-    m_graphicsView->setSceneRect( QRectF( m_gobChartsView->rect() ) );
+      m_snapshot.rows.clear();
+      m_snapshot.categories.clear();
+      m_snapshot.values.clear();
 
-    m_innerSceneRectF.setRect( m_gobChartsView->rect().x() + m_leftRightMargin,
-                               m_gobChartsView->rect().y() + m_topBottomMargin,
-                               m_gobChartsView->rect().width()  - 2 * m_leftRightMargin,
-                               m_gobChartsView->rect().height() - 2 * m_topBottomMargin );
+      m_snapshot.rows.reserve( rows.size() );
+      m_snapshot.categories.reserve( rows.size() );
+      m_snapshot.values.reserve( rows.size() );
 
-    m_grid->setGridRectF( QRectF( m_innerSceneRectF.left(),
-                                  m_innerSceneRectF.top(),
-                                  m_innerSceneRectF.width(),
-                                  m_innerSceneRectF.height() ) );
+      foreach( int row, rows )
+      {
+        m_snapshot.rows.append( row );
+        m_snapshot.categories.append( m_validItems->category( row ) );
+        m_snapshot.values.append( m_validItems->data( row ) );
+      }
 
-    m_header->setRectF( QRectF( QPointF( m_innerSceneRectF.left(), m_topBottomMargin * PERC_HEADER_TOP ),
-                                QSizeF( m_innerSceneRectF.width(), m_topBottomMargin * PERC_HEADER_SPACE ) ) );
+      m_snapshotDirty = false;
+      m_pyramidDirty  = true;
+    }
 
-    m_xLabel->setRectF( QRectF( QPointF( m_innerSceneRectF.left(), m_gobChartsView->rect().height() - m_topBottomMargin * PERC_XLABEL_BOTTOM ),
-                                QSizeF( m_innerSceneRectF.width(), m_topBottomMargin * PERC_XLABEL_SPACE ) ) );
+    /* Only rebuilt when the valid items or the allowed data range change, not for every zoom or pan step. */
+    if( m_visibleDirty )
+    {
+      m_snapshot.visiblePositions = m_gobChartsView->visiblePositions();
+      m_visibleDirty = false;
+      m_pyramidDirty = true;
+    }
 
-    m_yLabel->setRectF( QRectF( QPointF( m_leftRightMargin * PERC_YLABEL_LEFT, m_innerSceneRectF.top() ),
-                                QSizeF( m_leftRightMargin * PERC_YLABEL_SPACE, m_innerSceneRectF.height() ) ) );
-  }
+    if( isZoomed() )
+    {
+      m_snapshot.rangeFirst = m_zoomFirst;
+      m_snapshot.rangeLast  = m_zoomLast;
+    }
+    else
+    {
+      m_snapshot.rangeFirst = -1;
+      m_snapshot.rangeLast  = -1;
+    }
 
-  /*--------------------------------------------------------------------------------*/
+    /* The pyramid is only needed (and only kept up to date) while the displayed range holds more positions than
+      can be told apart, zoomed or not.  Speculative layouts may need it for BAR and LINE even if PIE is displayed. */
+    int displayed = isZoomed() ? ( qMin( m_zoomLast, m_snapshot.size() - 1 ) - m_zoomFirst + 1 ) : m_snapshot.size();
+    bool summarise = ( m_strategy->supportsZoom() || m_speculative ) && !m_strategy->isStreaming() && !isScrolling() &&
+                     ( displayed > GobChartsLayout::maxDistinctPositions( m_innerSceneRectF ) );
 
-  QString labelText( GobChartsLabel label )
-  {
-    if( m_labels.contains( label ) )
+    if( summarise )
     {
-      return m_labels.value( label )->toPlainText();
+      if( m_pyramidDirty )
+      {
+        m_snapshot.pyramid.build( m_snapshot.values, m_snapshot.visiblePositions );
+        m_pyramidDirty = false;
+      }
+    }
+    else if( m_snapshot.pyramid.size() > 0 )
+    {
+      m_snapshot.pyramid.clear();
+      m_pyramidDirty = true;
     }
 
-    return  QString( "" );
+    m_snapshot.totalValue       = m_totalValue;
+    m_snapshot.maxValue         = m_maxValue;
+    m_snapshot.useFixedColour   = m_fixedColourOn;
+    m_snapshot.fixedColour      = m_fixedColour;
+    m_snapshot.version          = m_layoutVersion.fetchAndAddOrdered( 1 ) + 1;
+
+    updateSceneMemory();
+    return m_snapshot;
   }
 
   /*--------------------------------------------------------------------------------*/
 
-  QFont labelFont( GobChartsLabel label )
+  /* Starts laying out the latest snapshot on a worker thread. */
+  void startLayout()
   {
-    if( m_labels.contains( label ) )
+    if( m_layoutWatcher->isRunning() )
     {
-      return m_labels.value( label )->font();
+      /* The running calculation will notice that it has been superseded and bail out, the latest
+        snapshot is laid out as soon as it does (this way stale requests never queue up). */
+      m_layoutPending = true;
+    }
+    else
+    {
+      m_layoutPending = false;
+      m_layoutWatcher->setFuture( QtConcurrent::run( GobChartsLayout::calculate,
+                                                     m_strategy->chartType(),
+                                                     m_snapshot,
+                                                     layoutRect(),
+                                                     &m_layoutVersion ) );
     }
-
-    return QFont();
   }
 
   /*--------------------------------------------------------------------------------*/
 
-  QColor labelColour( GobChartsLabel label )
+  /* Starts laying out the latest snapshot for all the chart types that aren't currently displayed. */
+  void startSpeculativeLayouts()
   {
-    if( m_labels.contains( label ) )
+    clearSpeculativeLayouts();
+
+    if( m_speculativeWatcher->isRunning() )
     {
-      return m_labels.value( label )->defaultTextColor();
+      m_speculativePending = true;    // see startLayout()
+      return;
     }
 
-    return QColor();
-  }
+    m_speculativePending = false;
 
-  /*--------------------------------------------------------------------------------*/
+    QList< GobChartsType > types;
+    types << BAR << PIE << LINE;
+    types.removeAll( m_strategy->chartType() );
 
-  Qt::Alignment labelAlignment( GobChartsLabel label )
-  {
-    if( m_labels.contains( label ) )
+    if( m_scrolling )
     {
-      return m_labels.value( label )->alignment();
+      types.removeAll( BAR );   // see setChartType()
     }
 
-    return Qt::AlignHCenter;
-  }
+    /* Don't calculate what can't be kept anyway. */
+    qint64 available = m_speculativeBudget;
 
-  /*--------------------------------------------------------------------------------*/
+    foreach( GobChartsType type, types )
+    {
+      qint64 bytes = EstimatedGeometryMemory( GobChartsLayout::itemCount( type, m_snapshot, m_innerSceneRectF ) );
 
-  GobChartsTextItem *labelGraphicsItem( GobChartsLabel label )
-  {
-    if( m_labels.contains( label ) )
+      if( bytes > available )
+      {
+        emitDebugLogMsg( tr( "GobChartsView::startSpeculativeLayouts# Layout of approximately [%1] bytes would exceed the memory budget." ).arg( bytes ) );
+        types.removeAll( type );
+      }
+      else
+      {
+        available -= bytes;
+      }
+    }
+
+    if( types.isEmpty() )
     {
-      return const_cast< GobChartsTextItem* >( m_labels.value( label ) );
+      return;
     }
 
-    /* We really shouldn't ever get here...but rather safe than sorry. */
-    return m_header;
+    m_speculativeWatcher->setFuture( QtConcurrent::run( CalculateAlternateLayouts,
+                                                        types,
+                                                        m_snapshot,
+                                                        m_innerSceneRectF,
+                                                        &m_layoutVersion ) );
   }
 
   /*--------------------------------------------------------------------------------*/
 
-  /* Constructor and destructor. */
-  GobChartsViewPrivate( GobChartsView * view )
-    :
-    m_gobChartsView    ( view ),
-    m_graphicsView     ( new QGraphicsView ),
-    m_graphScene       ( new QGraphicsScene ),
-    m_header           ( new GobChartsTextItem( Qt::Horizontal, "HEADER" ) ),
-    m_yLabel           ( new GobChartsTextItem( Qt::Vertical,   "YLABEL" ) ),
-    m_xLabel           ( new GobChartsTextItem( Qt::Horizontal, "XLABEL" ) ),
-    m_graphItems       ( new GobChartsGraphItems ),
-    m_grid             ( new GobChartsGrid ),
-    m_validItems       ( new GobChartsValidItems ),
-    m_selectedLabel    ( NONE ),
-    m_innerSceneRectF  (),
-    m_fixedColour      (),
-    m_legendText       ( "" ),
-    m_leftRightMargin  ( 0.0 ),
-    m_topBottomMargin  ( 0.0 ),
-    m_maxValue         ( 0.0 ),    
-    m_lowerDataBoundary( 0.0 ),
-    m_upperDataBoundary( 0.0 ),
-    m_totalValue       ( 0.0 ),
-    m_maxRow           ( 0 ),
-    m_showTotalRange   ( true ),
-    m_loggingOn        ( false ),
-    m_fixedColourOn    ( false ),
-    m_chartIsLoading   ( false )
+  /* Caches "geometry" (for switching to its chart type) if it is up to date and fits within the memory budget. */
+  void cacheSpeculativeLayout( const GobChartsGeometry &geometry )
   {
-    m_graphScene->setBackgroundBrush( QBrush( QColor( 245,245,245 ) ) );
+    if( !isSpeculativeCurrent( geometry ) )
+    {
+      return;
+    }
 
-    m_graphScene->addItem( m_header );  // takes ownership
-    m_graphScene->addItem( m_xLabel );  // takes ownership
-    m_graphScene->addItem( m_yLabel );  // takes ownership
+    m_speculativeMemory -= m_speculativeLayouts.contains( geometry.type ) ? GeometryMemory( m_speculativeLayouts.value( geometry.type ) ) : 0;
+    m_speculativeLayouts.remove( geometry.type );
 
-    m_graphicsView->setScene( m_graphScene );
-    m_graphicsView->setResizeAnchor( QGraphicsView::AnchorViewCenter );
-    m_graphicsView->setHorizontalScrollBarPolicy( Qt::ScrollBarAlwaysOff );
-    m_graphicsView->setVerticalScrollBarPolicy( Qt::ScrollBarAlwaysOff );
+    qint64 bytes = GeometryMemory( geometry );
 
-    /* Convenience mapping. */
-    m_labels.insert( HEADER, m_header );
-    m_labels.insert( YLABEL, m_yLabel );
-    m_labels.insert( XLABEL, m_xLabel );
+    if( m_speculativeMemory + bytes > m_speculativeBudget )
+    {
+      emitDebugLogMsg( tr( "GobChartsView::cacheSpeculativeLayout# Layout of [%1] bytes exceeds the memory budget." ).arg( bytes ) );
+    }
+    else
+    {
+      m_speculativeLayouts.insert( geometry.type, geometry );
+      m_speculativeMemory += bytes;
+    }
 
-    m_labelNames.insert( "HEADER", HEADER );
-    m_labelNames.insert( "YLABEL", YLABEL );
-    m_labelNames.insert( "XLABEL", XLABEL );
+    updateSceneMemory();
   }
 
-  ~GobChartsViewPrivate()
+  /*--------------------------------------------------------------------------------*/
+
+  void clearSpeculativeLayouts()
   {
-    m_graphItems->removeItemsFromScene( m_graphScene );
-    m_grid->removeGridFromScene( m_graphScene );
+    m_speculativeLayouts.clear();
+    m_speculativeMemory = 0;
+    updateSceneMemory();
+  }
 
-    delete m_graphicsView;
-    delete m_graphScene;
-    delete m_graphItems;
-    delete m_grid;
-    delete m_validItems;
+  /*--------------------------------------------------------------------------------*/
+
+  /* Returns "true" if "geometry" was calculated from the latest snapshot for the current inner rectangle.  Unlike
+    isCurrent(), this does not consult m_layoutVersion, which is also incremented when the chart type changes. */
+  bool isSpeculativeCurrent( const GobChartsGeometry &geometry ) const
+  {
+    return !geometry.cancelled && ( geometry.version == m_snapshot.version ) && ( geometry.innerRect == m_innerSceneRectF );
   }
 
-  GobChartsView       *m_gobChartsView;       // pointer to the object to which we have friend access to
-  QGraphicsView       *m_graphicsView;
-  QGraphicsScene      *m_graphScene;
-  GobChartsTextItem   *m_header;
-  GobChartsTextItem   *m_yLabel;
-  GobChartsTextItem   *m_xLabel;
-  GobChartsGraphItems *m_graphItems;
-  GobChartsGrid       *m_grid;
-  GobChartsValidItems *m_validItems;
-  GobChartsLabel       m_selectedLabel;       // to keep track of the selected text item to ensure the correct item receives the keyboard input
-  QRectF               m_innerSceneRectF;
-  QColor               m_fixedColour;
-  QString              m_legendText;
-  qreal                m_leftRightMargin;
-  qreal                m_topBottomMargin;
-  qreal                m_maxValue;
-  qreal                m_lowerDataBoundary;
-  qreal                m_upperDataBoundary;
-  qreal                m_totalValue;
-  int                  m_maxRow;              // the last row containing valid items
-  bool                 m_showTotalRange;
-  bool                 m_loggingOn;
-  bool                 m_fixedColourOn;
-  bool                 m_chartIsLoading;
+  /*--------------------------------------------------------------------------------*/
 
-  /* Convenience mappings to rid us of all the "switch" statements required otherwise. */
-  QMap< GobChartsLabel, GobChartsTextItem* > m_labels;
-  QMap< QString,        GobChartsLabel     > m_labelNames;
-};
+  /* Returns "true" if the chart is zoomed into a range of positions. */
+  bool isZoomed() const
+  {
+    return ( m_zoomFirst >= 0 ) && m_strategy->supportsZoom() && !m_strategy->isStreaming() && !isScrolling();
+  }
 
+  /*--------------------------------------------------------------------------------*/
 
-/*------------------------------- MEMBER FUNCTIONS -------------------------------*/
+  /* Sets the zoomed range to "span" positions starting at "first" (both clamped to the data). */
+  void zoomTo( int first, int span )
+  {
+    int size = m_gobChartsView->nrValidItems();
+    span  = qBound( qMin( MIN_ZOOM_SPAN, size ), span, size );
+    first = qBound( 0, first, size - span );
 
-GobChartsView::GobChartsView( QWidget *parent ) :
-  QAbstractItemView( parent ),
-  m_private        ( new GobChartsViewPrivate( this ) )
-{
-  setHorizontalScrollBarPolicy( Qt::ScrollBarAlwaysOff );
-  setVerticalScrollBarPolicy( Qt::ScrollBarAlwaysOff );
+    m_gobChartsView->setZoomRange( first, first + span - 1 );
+  }
 
-  m_private->calculateGeometries();
+  /*--------------------------------------------------------------------------------*/
 
-  /* Labels. */
-  connect( m_private->m_header, SIGNAL( identity           ( const QString& ) ),
-                          this, SLOT  ( setSelectedTextItem( const QString& ) ) );
+  /* Returns the first position and number of positions currently displayed. */
+  void displayedRange( int &first, int &span ) const
+  {
+    if( isZoomed() )
+    {
+      first = m_zoomFirst;
+      span  = m_zoomLast - m_zoomFirst + 1;
+    }
+    else
+    {
+      first = 0;
+      span  = m_gobChartsView->nrValidItems();
+    }
+  }
 
-  connect( m_private->m_xLabel, SIGNAL( identity           ( const QString& ) ),
-                          this, SLOT  ( setSelectedTextItem( const QString& ) ) );
+  /*--------------------------------------------------------------------------------*/
 
-  connect( m_private->m_yLabel, SIGNAL( identity           ( const QString& ) ),
-                          this, SLOT  ( setSelectedTextItem( const QString& ) ) );
+  /* Zooms in ("factor" < 1) or out ("factor" > 1) keeping the position under "viewportPos" in place. */
+  void zoomAt( const QPoint &viewportPos, qreal factor )
+  {
+    int first( 0 );
+    int span ( 0 );
+    displayedRange( first, span );
 
-  /* Debug logging. */
-  connect( m_private->m_graphItems, SIGNAL( lastDebugLogMsg( QString ) ), this, SLOT( debugLog( QString ) ) );
-  connect( m_private->m_grid,       SIGNAL( lastDebugLogMsg( QString ) ), this, SLOT( debugLog( QString ) ) );
+    if( span <= 0 || m_innerSceneRectF.width() <= 0.0 || qFuzzyCompare( factor, 1.0 ) )
+    {
+      return;
+    }
 
-  QVBoxLayout *layout = new QVBoxLayout;
-  layout->addWidget( m_private->m_graphicsView );
-  setLayout( layout );
+    qreal fraction = ( m_graphicsView->mapToScene( viewportPos ).x() - m_innerSceneRectF.left() )/m_innerSceneRectF.width();
+    fraction = qBound( 0.0, fraction, 1.0 );
 
-  setViewport( m_private->m_graphicsView );
-}
+    int newSpan = qMax( 1, qRound( span * factor ) );
 
-/*--------------------------------------------------------------------------------*/
+    if( newSpan == span )
+    {
+      newSpan += ( factor > 1.0 ) ? 1 : -1;
+    }
 
-GobChartsView::~GobChartsView() 
-{
-  delete m_private;
-}
+    zoomTo( qRound( first + fraction * span - fraction * newSpan ), newSpan );
+  }
 
-/*--------------------------------------------------------------------------------*/
+  /*--------------------------------------------------------------------------------*/
 
-void GobChartsView::setLabelDetails( GobChartsLabel label, const QString &text, const QFont &font, const QColor &colour, Qt::Alignment align )
-{
-  if( m_private->m_labels.contains( label ) )
+  /* Returns "true" if the chart is a scrolling BAR chart. */
+  bool isScrolling() const
   {
-    /* Values returned from the map aren't modifiable by default. */
-    const_cast< GobChartsTextItem* >( m_private->m_labels.value( label ) )->setPlainText( text );
-    const_cast< GobChartsTextItem* >( m_private->m_labels.value( label ) )->setMaxFontSize( font );
-    const_cast< GobChartsTextItem* >( m_private->m_labels.value( label ) )->setAlignment( align );
-    const_cast< GobChartsTextItem* >( m_private->m_labels.value( label ) )->setDefaultTextColor( colour );
+    return m_scrolling && ( m_strategy->chartType() == BAR ) && !m_strategy->isStreaming();
   }
-}
 
-/*--------------------------------------------------------------------------------*/
+  /*--------------------------------------------------------------------------------*/
+
+  /* Returns the rectangle the chart is laid out in.  In scrolling mode, this is the inner rectangle
+    stretched to fit all the bars at their minimum width. */
+  QRectF layoutRect() const
+  {
+    if( !isScrolling() )
+    {
+      return m_innerSceneRectF;
+    }
+
+    QRectF rect( m_innerSceneRectF );
+    rect.setWidth( qMax( rect.width(), GobChartsLayout::barContentWidth( m_snapshot.size(), m_minimumBarWidth ) ) );
+    return rect;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Returns the bars that fall within the visible window of a scrolling chart, clipped to the inner rectangle and
+    shifted by the scroll offset.  Only these bars are laid out (straight from the snapshot), their number depends
+    on the width of the view, not on the data. */
+  GobChartsGeometry scrollWindow() const
+  {
+    qreal offset = m_gobChartsView->horizontalScrollBar()->value();
+
+    GobChartsGeometry window = GobChartsLayout::calculateBarWindow( m_snapshot,
+                                                                    m_scrollContentRect,
+                                                                    m_innerSceneRectF.left() + offset,
+                                                                    m_innerSceneRectF.right() + offset );
+    window.innerRect = m_innerSceneRectF;
+
+    QVector< GobChartsGeometryItem >::iterator it = window.items.begin();
+
+    while( it != window.items.end() )
+    {
+      it->rect.translate( -offset, 0.0 );
+      it->point.rx()         -= offset;
+      it->previousPoint.rx() -= offset;
+
+      /* Bars cut by the edges of the window must not spill into the margins. */
+      it->rect.setLeft ( qMax( it->rect.left(),  m_innerSceneRectF.left() ) );
+      it->rect.setRight( qMin( it->rect.right(), m_innerSceneRectF.right() ) );
+
+      if( it->rect.width() > 0.0 )
+      {
+        ++it;
+      }
+      else
+      {
+        it = window.items.erase( it );
+      }
+    }
+
+    return window;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Fills the legend with all the bars of a scrolling chart (not only those in the visible window) so that it
+    doesn't change while scrolling and any bar can be scrolled to by selecting its legend item. */
+  void updateScrollLegend()
+  {
+    m_scrollLegendIndex.clear();
+    emit m_gobChartsView->clearLegend();
+
+    foreach( int position, m_snapshot.visiblePositions )
+    {
+      GobChartsGeometryItem item = GobChartsLayout::baseItem( m_snapshot, position );
+      emit m_gobChartsView->createLegendItem( item.colour, item.legendText );
+
+      /* Legend lookups find the first bar with a given text. */
+      if( !m_scrollLegendIndex.contains( item.legendText ) )
+      {
+        m_scrollLegendIndex.insert( item.legendText, position );
+      }
+    }
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Returns the snapshot position of model row "row", or -1 if the row isn't represented. */
+  int positionForRow( int row ) const
+  {
+    QVector< int >::const_iterator it = std::lower_bound( m_snapshot.rows.constBegin(), m_snapshot.rows.constEnd(), row );
+
+    if( it == m_snapshot.rows.constEnd() || *it != row )
+    {
+      return -1;
+    }
+
+    return static_cast< int >( it - m_snapshot.rows.constBegin() );
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Sets the range of the horizontal scroll bar without scrolling the chart as a side effect. */
+  void updateScrollRange( int maximum )
+  {
+    QScrollBar *scrollBar = m_gobChartsView->horizontalScrollBar();
+
+    m_scrollRangeUpdate = true;
+    scrollBar->setRange( 0, qMax( 0, maximum ) );
+    scrollBar->setPageStep( qMax( 1, qRound( m_innerSceneRectF.width() ) ) );
+    scrollBar->setSingleStep( qMax( 1, qRound( m_minimumBarWidth ) ) );
+    m_scrollRangeUpdate = false;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Returns "true" if "geometry" was calculated from the latest snapshot. */
+  bool isCurrent( const GobChartsGeometry &geometry )
+  {
+    return !geometry.cancelled && ( geometry.version == m_layoutVersion.fetchAndAddOrdered( 0 ) );
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* All redraw requests go through here.  Without a frame rate cap the chart is redrawn immediately,
+    otherwise the request is merged into the next scheduled frame. */
+  void scheduleRedraw()
+  {
+    if( m_updateDepth > 0 )
+    {
+      /* Inside a beginUpdate()/endUpdate() transaction, endUpdate() redraws. */
+      if( m_updateDirty )
+      {
+        m_frameClock.countMergedRequest();
+      }
+
+      m_updateDirty = true;
+      return;
+    }
+
+    if( deferWhileHidden() )
+    {
+      return;
+    }
+
+    if( !m_frameClock.isCapped() )
+    {
+      renderFrame();
+      return;
+    }
+
+    if( m_redrawPending )
+    {
+      m_frameClock.countMergedRequest();
+      return;
+    }
+
+    m_redrawPending = true;
+
+    if( !m_renderTimer->isActive() )
+    {
+      m_renderTimer->start( m_frameClock.timeToNextFrame() );
+    }
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Returns "true" (and remembers that a redraw is due) if the chart can't currently be seen, in which
+    case there is no point in laying it out or painting it.  showEvent() catches up. */
+  bool deferWhileHidden()
+  {
+    if( isOnScreen() )
+    {
+      return false;
+    }
+
+    if( m_hiddenDirty )
+    {
+      m_frameClock.countMergedRequest();
+    }
+
+    m_hiddenDirty = true;
+    return true;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Returns "true" if the chart is visible and its window isn't minimised. */
+  bool isOnScreen() const
+  {
+    return m_gobChartsView->isVisible() && !m_gobChartsView->window()->isMinimized();
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Returns the (approximate) number of bytes that hibernating would release.  The category strings are
+    shared with the valid items and therefore not counted. */
+  qint64 sceneMemory() const
+  {
+    qint64 bytes = m_geometryMemory + m_speculativeMemory;
+
+    if( !isDirect() )
+    {
+      bytes += m_geometry.items.size() * ITEM_MEMORY_ESTIMATE;
+    }
+
+    bytes += m_snapshot.rows.capacity() * sizeof( int );
+    bytes += m_snapshot.categories.capacity() * sizeof( QString );
+    bytes += m_snapshot.values.capacity() * sizeof( qreal );
+    bytes += m_snapshot.visiblePositions.size() * sizeof( void* );
+    bytes += m_snapshot.pyramid.size() * 2 * sizeof( GobChartsPyramidBucket );
+
+    return bytes;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Reports the scene memory estimate to the hibernation registry, to be called whenever the geometry, the speculative
+    layouts or the data snapshot change (sceneMemory() is cheap, the geometry's memory is cached). */
+  void updateSceneMemory()
+  {
+    GobChartsHibernation::setSceneMemory( this, sceneMemory() );
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Releases everything that can be rebuilt from the valid items (graphics items, layouts, data snapshot
+    and grid paths) and returns "true", unless the chart is on screen, streaming or already hibernating.
+    The chart is rebuilt by showEvent(). */
+  bool hibernate()
+  {
+    if( m_hibernating || m_strategy->isStreaming() || isOnScreen() )
+    {
+      return false;
+    }
+
+    qint64 before = sceneMemory();
+
+    /* Layouts that are still running were calculated from the snapshot released below. */
+    m_layoutVersion.fetchAndAddOrdered( 1 );
+    m_layoutPending      = false;
+    m_speculativePending = false;
+
+    cancelProgressiveBuild();
+    clearRange();
+    clearHover();
+
+    m_graphItems->removeItemsFromScene( m_graphScene );
+    m_graphItems->deleteItems();
+    m_geometry          = GobChartsGeometry();
+    m_geometryMemory    = GeometryMemory( m_geometry );
+    m_directLegendIndex.clear();
+    m_scrollContentRect = QRectF();
+    m_scrollLegendIndex.clear();
+    m_directSelectedRow = -1;
+    clearSpeculativeLayouts();
+
+    /* Assigning empty vectors (rather than clearing them) releases their capacity. */
+    m_snapshot.rows       = QVector< int >();
+    m_snapshot.categories = QVector< QString >();
+    m_snapshot.values     = QVector< qreal >();
+    m_snapshot.visiblePositions = QList< int >();
+    m_snapshot.pyramid.clear();
+    m_snapshotDirty = true;
+    m_visibleDirty  = true;
+    m_pyramidDirty  = true;
+
+    m_grid->removeGridFromScene( m_graphScene );
+    m_grid->releaseGrid();
+    m_graphicsView->resetCachedContent();
+
+    emit m_gobChartsView->clearLegend();
+
+    updateSceneMemory();
+
+    qint64 reclaimed = qMax( qint64( 0 ), before - sceneMemory() );
+    m_hibernationStats.hibernations++;
+    m_hibernationStats.lastReclaimed   = reclaimed;
+    m_hibernationStats.totalReclaimed += reclaimed;
+
+    m_hibernating = true;
+    m_hiddenDirty = true;   // showEvent() rebuilds the chart
+
+    emitDebugLogMsg( tr( "GobChartsView::hibernate# Released approximately [%1] bytes." ).arg( reclaimed ) );
+    return true;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Redraws the chart and updates the render statistics. */
+  void renderFrame()
+  {
+    m_redrawPending = false;
+
+    m_frameClock.beginFrame();
+    m_gobChartsView->drawChart();
+    GobChartsHibernation::enforceMemoryBudget();
+
+    int skipped = m_frameClock.endFrame();
+
+    if( skipped > 0 )
+    {
+      emitDebugLogMsg( tr( "GobChartsView::renderFrame# Render took [%1] ms, dropping [%2] frame(s)." ).arg( m_frameClock.stats().lastRenderTime ).arg( skipped ) );
+    }
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Returns "true" if the chart items are painted directly rather than via the scene. */
+  bool isDirect() const
+  {
+    return ( m_backend == DIRECT_BACKEND ) && !m_strategy->isStreaming();
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Returns the index into m_geometry.items of the item representing "row", or -1.  Items are
+    stored in position order, which is also ascending row order. */
+  int directItemForRow( int row ) const
+  {
+    int i = GobChartsLayout::lowerBoundRow( m_geometry, row );
+    return ( i < m_geometry.items.size() && m_geometry.items.at( i ).row == row ) ? i : -1;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Returns the scene rectangle covered by m_geometry.items[ i ] (BAR and LINE). */
+  QRectF itemRect( int i ) const
+  {
+    const GobChartsGeometryItem &item = m_geometry.items.at( i );
+
+    if( m_geometry.type == LINE )
+    {
+      return QRectF( item.point, item.point ).adjusted( -RANGE_POINT_MARGIN, -RANGE_POINT_MARGIN, RANGE_POINT_MARGIN, RANGE_POINT_MARGIN );
+    }
+
+    return item.rect;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Returns "true" if "item" is one of the labels or the header. */
+  bool isLabel( QGraphicsItem *item ) const
+  {
+    foreach( GobChartsTextItem *label, m_labels )
+    {
+      if( item && item == label )
+      {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Returns the outline (in scene coordinates) of m_geometry.items[ i ]. */
+  QPainterPath itemOutline( int i ) const
+  {
+    const GobChartsGeometryItem &item = m_geometry.items.at( i );
+    QPainterPath path;
+
+    switch( m_geometry.type )
+    {
+    case BAR:
+      path.addRect( item.rect );
+      break;
+    case LINE:
+      path.addEllipse( item.point, HOVER_POINT_RADIUS, HOVER_POINT_RADIUS );
+      break;
+    case PIE:
+      path.moveTo( item.rect.center() );
+      path.arcTo( item.rect, item.startAngle/16.0, item.spanAngle/16.0 );
+      path.closeSubpath();
+      break;
+    }
+
+    return path;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Hit tests the last known mouse position against the geometry (not the scene) and moves the
+    hover outline and tooltip if the item under the mouse has changed. */
+  void updateHover()
+  {
+    int i = -1;
+
+    if( !m_strategy->isStreaming() && m_graphicsView->viewport()->underMouse() )
+    {
+      i = GobChartsLayout::hitTest( m_geometry, m_graphicsView->mapToScene( m_hoverPos ) );
+    }
+
+    if( i == m_hoverIndex )
+    {
+      return;
+    }
+
+    clearHover();
+
+    if( i < 0 )
+    {
+      return;
+    }
+
+    m_hoverIndex = i;
+    m_hoverPath  = itemOutline( i );
+
+    if( isDirect() )
+    {
+      m_graphicsView->viewport()->update( m_graphicsView->mapFromScene( m_hoverPath.boundingRect() ).boundingRect().adjusted( -2, -2, 2, 2 ) );
+    }
+    else
+    {
+      m_hoverItem = new QGraphicsPathItem( m_hoverPath );
+      m_hoverItem->setPen( hoverPen() );
+      m_hoverItem->setZValue( HOVER_OUTLINE_Z );
+      m_graphScene->addItem( m_hoverItem );   // takes ownership
+    }
+
+    QToolTip::showText( m_graphicsView->viewport()->mapToGlobal( m_hoverPos ),
+                        m_geometry.items.at( i ).legendText,
+                        m_graphicsView->viewport() );
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Removes the hover outline and tooltip (if any). */
+  void clearHover()
+  {
+    if( m_hoverItem )
+    {
+      m_graphScene->removeItem( m_hoverItem );
+      delete m_hoverItem;
+      m_hoverItem = NULLPOINTER;
+    }
+
+    if( m_hoverIndex >= 0 )
+    {
+      if( isDirect() )
+      {
+        m_graphicsView->viewport()->update( m_graphicsView->mapFromScene( m_hoverPath.boundingRect() ).boundingRect().adjusted( -2, -2, 2, 2 ) );
+      }
+
+      QToolTip::hideText();
+    }
+
+    m_hoverIndex = -1;
+    m_hoverPath  = QPainterPath();
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  QPen hoverPen() const
+  {
+    QPen pen( m_gobChartsView->palette().color( QPalette::Highlight ) );
+    pen.setWidth( 2 );
+    pen.setCosmetic( true );
+    return pen;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Returns "true" if rubber band (range) selection is possible for the current chart. */
+  bool rangeSelectionAllowed() const
+  {
+    return ( m_geometry.type != PIE ) && !m_strategy->isStreaming() && !m_geometry.items.isEmpty();
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Selects the contiguous range of items between the left and right edges of "sceneRect" and
+    highlights it with a single overlay (rather than touching every item in the range). */
+  void selectRange( const QRectF &sceneRect )
+  {
+    clearRange();
+
+    int first( -1 );
+    int last ( -1 );
+
+    if( !GobChartsLayout::rangeQuery( m_geometry, sceneRect.left(), sceneRect.right(), first, last ) )
+    {
+      return;
+    }
+
+    m_graphItems->clearSelection();
+    m_directSelectedRow = -1;
+
+    QRectF extent = itemRect( first ).united( itemRect( last ) );
+    m_rangeRect = QRectF( QPointF( extent.left(),  m_innerSceneRectF.top() ),
+                          QPointF( extent.right(), m_innerSceneRectF.bottom() ) );
+
+    QColor colour = m_gobChartsView->palette().color( QPalette::Highlight );
+    colour.setAlpha( RANGE_OVERLAY_ALPHA );
+
+    if( isDirect() )
+    {
+      m_graphicsView->viewport()->update();
+    }
+    else
+    {
+      m_rangeItem = new QGraphicsRectItem( m_rangeRect );
+      m_rangeItem->setPen( Qt::NoPen );
+      m_rangeItem->setBrush( colour );
+      m_rangeItem->setZValue( RANGE_OVERLAY_Z );
+      m_graphScene->addItem( m_rangeItem );   // takes ownership
+    }
+
+    if( m_gobChartsView->selectionModel() )
+    {
+      QAbstractItemModel *model = m_gobChartsView->model();
+      QItemSelection selection( model->index( m_geometry.items.at( first ).row, VALUE, m_gobChartsView->rootIndex() ),
+                                model->index( m_geometry.items.at( last ).row,  VALUE, m_gobChartsView->rootIndex() ) );
+
+      m_gobChartsView->selectionModel()->select( selection, QItemSelectionModel::ClearAndSelect );
+    }
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Removes the range selection overlay (if any). */
+  void clearRange()
+  {
+    if( m_rangeItem )
+    {
+      m_graphScene->removeItem( m_rangeItem );
+      delete m_rangeItem;
+      m_rangeItem = NULLPOINTER;
+    }
+
+    if( !m_rangeRect.isNull() )
+    {
+      m_rangeRect = QRectF();
+
+      if( isDirect() )
+      {
+        m_graphicsView->viewport()->update();
+      }
+    }
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Highlights the item representing "row" (if not highlighted already) without relayouting the chart: only
+    the previously and newly selected items are updated. */
+  void selectRow( int row )
+  {
+    int i = directItemForRow( row );
+
+    if( i < 0 )
+    {
+      return;
+    }
+
+    if( isDirect() )
+    {
+      if( m_directSelectedRow != row )
+      {
+        int previous = directItemForRow( m_directSelectedRow );
+        m_directSelectedRow = row;
+
+        updateDirectItem( previous );
+        updateDirectItem( i );
+      }
+    }
+    else if( m_graphItems->selectedRow() != row )
+    {
+      m_graphItems->setSelected( row );
+    }
+
+    m_legendText = m_geometry.items.at( i ).legendText;
+    emit m_gobChartsView->highLightLegendItem( m_legendText );
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Repaints the part of the viewport covered by m_geometry.items[ i ] (DIRECT_BACKEND). */
+  void updateDirectItem( int i )
+  {
+    if( i < 0 )
+    {
+      return;
+    }
+
+    const GobChartsGeometryItem &item = m_geometry.items.at( i );
+    QRectF rect = item.rect;
+
+    if( m_geometry.type == LINE )
+    {
+      rect = QRectF( item.previousPoint, item.point ).normalized();
+
+      if( !item.span.isNull() )
+      {
+        rect = rect.united( QRectF( item.span.p1(), item.span.p2() ).normalized() );
+      }
+
+      rect.adjust( -5.0, -5.0, 5.0, 5.0 );
+    }
+
+    m_graphicsView->viewport()->update( m_graphicsView->mapFromScene( rect ).boundingRect().adjusted( -2, -2, 2, 2 ) );
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Returns the index into m_geometry.items of the item with legend "text", or -1. */
+  int directItemForLegend( const QString &text ) const
+  {
+    return m_directLegendIndex.value( text, -1 );
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Paints the entire chart onto the graphics view's viewport (DIRECT_BACKEND). */
+  void paintDirect( QPainter *painter )
+  {
+    painter->fillRect( m_graphicsView->viewport()->rect(), m_graphScene->backgroundBrush() );
+    painter->setRenderHints( m_graphicsView->renderHints() );
+    painter->setTransform( m_graphicsView->viewportTransform() );
+
+    if( m_strategy->needsGrid() )
+    {
+      m_grid->paintGrid( painter );
+    }
+
+    foreach( const GobChartsGeometryItem &item, m_geometry.items )
+    {
+      painter->save();
+
+      if( item.row == m_directSelectedRow )
+      {
+        painter->setOpacity( SELECTED_OPACITY );
+      }
+
+      m_strategy->paintItem( painter, item );
+      painter->restore();
+    }
+
+    if( !m_rangeRect.isNull() )
+    {
+      QColor colour = m_gobChartsView->palette().color( QPalette::Highlight );
+      colour.setAlpha( RANGE_OVERLAY_ALPHA );
+      painter->fillRect( m_rangeRect, colour );
+    }
+
+    if( m_hoverIndex >= 0 )
+    {
+      painter->strokePath( m_hoverPath, hoverPen() );
+    }
+
+    foreach( GobChartsTextItem *label, m_labels )
+    {
+      if( label->isVisible() )
+      {
+        QAbstractTextDocumentLayout::PaintContext context;
+        context.palette.setColor( QPalette::Text, label->defaultTextColor() );
+
+        painter->save();
+        painter->setTransform( label->sceneTransform(), true );
+        label->document()->documentLayout()->draw( painter, context );
+        painter->restore();
+      }
+    }
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Applies the current quality tier to the graphics view and the existing items.  Full quality restores
+    the render hints the graphics view had before quality was last reduced. */
+  void applyRenderQuality()
+  {
+    if( m_renderQuality == FULL_QUALITY )
+    {
+      m_graphicsView->setRenderHints( m_fullQualityHints );
+    }
+    else
+    {
+      m_graphicsView->setRenderHint( QPainter::Antialiasing, false );
+    }
+
+    m_graphItems->setEffectsEnabled( m_renderQuality == FULL_QUALITY );
+    m_graphicsView->viewport()->update();
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Drops to the interactive quality tier (if not already there) and (re)starts the countdown
+    to full quality. */
+  void interactionStarted()
+  {
+    if( m_interactiveQuality == FULL_QUALITY )
+    {
+      return;
+    }
+
+    if( m_renderQuality != m_interactiveQuality )
+    {
+      if( m_renderQuality == FULL_QUALITY )
+      {
+        m_fullQualityHints = m_graphicsView->renderHints();
+      }
+
+      m_renderQuality = m_interactiveQuality;
+      applyRenderQuality();
+    }
+
+    m_qualityTimer->start();
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Stops a progressive build that is still in progress and removes its preview. */
+  void cancelProgressiveBuild()
+  {
+    m_progressiveTimer->stop();
+    m_progressiveNext = 0;
+
+    if( m_previewItem )
+    {
+      m_graphScene->removeItem( m_previewItem );
+      delete m_previewItem;
+      m_previewItem = NULLPOINTER;
+    }
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Creates a coarse preview of "geometry" as a single path item: BAR and LINE items are aggregated
+    into buckets of PREVIEW_BUCKET_WIDTH (showing the maximum of each bucket), PIE charts are
+    previewed as a plain disc. */
+  void showPreview( const GobChartsGeometry &geometry )
+  {
+    QPainterPath path;
+    int count   = geometry.items.size();
+    int buckets = qMax( 1, static_cast< int >( geometry.innerRect.width() / PREVIEW_BUCKET_WIDTH ) );
+    int perBucket = qMax( 1, qCeil( count / static_cast< qreal >( buckets ) ) );
+
+    for( int first = 0; first < count; first += perBucket )
+    {
+      int last = qMin( first + perBucket, count );
+
+      if( geometry.type == BAR )
+      {
+        QRectF rect = geometry.items.at( first ).rect;
+
+        for( int i = first + 1; i < last; i++ )
+        {
+          rect = rect.united( geometry.items.at( i ).rect );
+        }
+
+        path.addRect( rect );
+      }
+      else if( geometry.type == LINE )
+      {
+        QPointF top = geometry.items.at( first ).point;
+
+        for( int i = first + 1; i < last; i++ )
+        {
+          if( geometry.items.at( i ).point.y() < top.y() )
+          {
+            top = geometry.items.at( i ).point;
+          }
+        }
+
+        if( first == 0 )
+        {
+          path.moveTo( top );
+        }
+        else
+        {
+          path.lineTo( top );
+        }
+      }
+      else
+      {
+        path.addEllipse( geometry.items.at( first ).rect );
+        break;
+      }
+    }
+
+    m_previewItem = new QGraphicsPathItem( path );
+    m_previewItem->setPen( QPen( Qt::gray ) );
+
+    if( geometry.type != LINE )
+    {
+      m_previewItem->setBrush( QColor( Qt::lightGray ) );
+    }
+
+    m_graphScene->addItem( m_previewItem );   // takes ownership
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Calculates and sets all the chart's dimensions and allowed areas. */
+  void calculateGeometries()
+  {
+    m_leftRightMargin = m_gobChartsView->rect().width()  * LEFT_RIGHT_MARGIN_PERC;
+    m_topBottomMargin = m_gobChartsView->rect().height() * TOP_BOTTOM_MARGIN_PERC;
+
+    m_graphScene->setSceneRect( QRectF( m_gobChartsView->rect() ) );
+    m_graphicsView->setSceneRect( QRectF( m_gobChartsView->rect() ) );
+
+    QRectF innerRect( m_gobChartsView->rect().x() + m_leftRightMargin,
+                      m_gobChartsView->rect().y() + m_topBottomMargin,
+                      m_gobChartsView->rect().width()  - 2 * m_leftRightMargin,
+                      m_gobChartsView->rect().height() - 2 * m_topBottomMargin );
+
+    /* Scene units per standard display pixel, for keeping grid lines visibly apart. */
+    qreal viewScale = m_graphicsView->transform().m11();
+    m_grid->setDeviceScale( ( m_graphicsView->logicalDpiX() / STANDARD_DPI ) / ( ( viewScale > 0.0 ) ? viewScale : 1.0 ) );
+
+    /* The static layers only depend on the geometry. */
+    if( m_layeredRendering && innerRect == m_innerSceneRectF )
+    {
+      return;
+    }
+
+    m_innerSceneRectF = innerRect;
+
+    m_grid->setGridRectF( QRectF( m_innerSceneRectF.left(),
+                                  m_innerSceneRectF.top(),
+                                  m_innerSceneRectF.width(),
+                                  m_innerSceneRectF.height() ) );
+
+    m_header->setRectF( QRectF( QPointF( m_innerSceneRectF.left(), m_topBottomMargin * PERC_HEADER_TOP ),
+                                QSizeF( m_innerSceneRectF.width(), m_topBottomMargin * PERC_HEADER_SPACE ) ) );
+
+    m_xLabel->setRectF( QRectF( QPointF( m_innerSceneRectF.left(), m_gobChartsView->rect().height() - m_topBottomMargin * PERC_XLABEL_BOTTOM ),
+                                QSizeF( m_innerSceneRectF.width(), m_topBottomMargin * PERC_XLABEL_SPACE ) ) );
+
+    m_yLabel->setRectF( QRectF( QPointF( m_leftRightMargin * PERC_YLABEL_LEFT, m_innerSceneRectF.top() ),
+                                QSizeF( m_leftRightMargin * PERC_YLABEL_SPACE, m_innerSceneRectF.height() ) ) );
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  QString labelText( GobChartsLabel label )
+  {
+    if( m_labels.contains( label ) )
+    {
+      return m_labels.value( label )->toPlainText();
+    }
+
+    return  QString( "" );
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  QFont labelFont( GobChartsLabel label )
+  {
+    if( m_labels.contains( label ) )
+    {
+      return m_labels.value( label )->font();
+    }
+
+    return QFont();
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  QColor labelColour( GobChartsLabel label )
+  {
+    if( m_labels.contains( label ) )
+    {
+      return m_labels.value( label )->defaultTextColor();
+    }
+
+    return QColor();
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  Qt::Alignment labelAlignment( GobChartsLabel label )
+  {
+    if( m_labels.contains( label ) )
+    {
+      return m_labels.value( label )->alignment();
+    }
+
+    return Qt::AlignHCenter;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  GobChartsTextItem *labelGraphicsItem( GobChartsLabel label )
+  {
+    if( m_labels.contains( label ) )
+    {
+      return const_cast< GobChartsTextItem* >( m_labels.value( label ) );
+    }
+
+    /* We really shouldn't ever get here...but rather safe than sorry. */
+    return m_header;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Keyboard input is forwarded to the selected label (see keyPressEvent()), a previously selected
+    label no longer receives it and returns to its static text display. */
+  void setSelectedLabel( GobChartsLabel label )
+  {
+    if( m_selectedLabel != label && m_labels.contains( m_selectedLabel ) )
+    {
+      labelGraphicsItem( m_selectedLabel )->endForwardedEditing();
+    }
+
+    m_selectedLabel = label;
+  }
+
+  /*--------------------------------------------------------------------------------*/
+
+  /* Constructor and destructor. */
+  GobChartsViewPrivate( GobChartsView * view )
+    :
+    m_gobChartsView    ( view ),
+    m_graphicsView     ( new QGraphicsView ),
+    m_graphScene       ( new QGraphicsScene ),
+    m_header           ( new GobChartsTextItem( Qt::Horizontal, "HEADER" ) ),
+    m_yLabel           ( new GobChartsTextItem( Qt::Vertical,   "YLABEL" ) ),
+    m_xLabel           ( new GobChartsTextItem( Qt::Horizontal, "XLABEL" ) ),
+    m_strategy         ( NULLPOINTER ),
+    m_graphItems       ( new GobChartsGraphItems ),
+    m_grid             ( new GobChartsGrid ),
+    m_validItems       ( new GobChartsValidItems ),
+    m_layoutWatcher    ( new QFutureWatcher< GobChartsGeometry > ),
+    m_speculativeWatcher( new QFutureWatcher< QList< GobChartsGeometry > > ),
+    m_speculativeLayouts(),
+    m_speculativeMemory( 0 ),
+    m_speculativeBudget( DEFAULT_SPECULATIVE_BUDGET ),
+    m_snapshot         (),
+    m_geometry         (),
+    m_geometryMemory   ( 0 ),
+    m_layoutVersion    ( 0 ),
+    m_ingestionQueue   ( NULLPOINTER ),
+    m_ingestionTimer   ( new QTimer ),
+    m_samples          (),
+    m_renderTimer      ( new QTimer ),
+    m_progressiveTimer ( new QTimer ),
+    m_previewItem      ( NULLPOINTER ),
+    m_rangeItem        ( NULLPOINTER ),
+    m_rangeRect        (),
+    m_rubberBand       ( NULLPOINTER ),
+    m_rubberBandOrigin (),
+    m_rubberBandArmed  ( false ),
+    m_hoverTimer       ( new QTimer ),
+    m_hoverItem        ( NULLPOINTER ),
+    m_hoverPath        (),
+    m_hoverPos         (),
+    m_hoverIndex       ( -1 ),
+    m_scrollContentRect(),
+    m_scrollLegendIndex(),
+    m_minimumBarWidth  ( DEFAULT_MIN_BAR_WIDTH ),
+    m_scrolling        ( false ),
+    m_scrollRangeUpdate( false ),
+    m_pyramidDirty     ( true ),
+    m_zoomFirst        ( -1 ),
+    m_zoomLast         ( -1 ),
+    m_panOrigin        (),
+    m_panFirst         ( 0 ),
+    m_panning          ( false ),
+    m_progressiveNext  ( 0 ),
+    m_timeSlice        ( DEFAULT_TIME_SLICE ),
+    m_qualityTimer     ( new QTimer ),
+    m_labelSyncTimer   ( new QTimer ),
+    m_keystrokeClock   (),
+    m_latencyPending   ( false ),
+    m_interactiveQuality( FULL_QUALITY ),
+    m_renderQuality    ( FULL_QUALITY ),
+    m_fullQualityHints (),
+    m_frameClock       (),
+    m_redrawPending    ( false ),
+    m_updateDepth      ( 0 ),
+    m_updateDirty      ( false ),
+    m_hiddenDirty      ( false ),
+    m_hibernateTimer   ( new QTimer ),
+    m_hibernationTimeout( 0 ),
+    m_hibernationStats (),
+    m_hibernating      ( false ),
+    m_selectedLabel    ( NONE ),
+    m_innerSceneRectF  (),
+    m_fixedColour      (),
+    m_legendText       ( "" ),
+    m_leftRightMargin  ( 0.0 ),
+    m_topBottomMargin  ( 0.0 ),
+    m_maxValue         ( 0.0 ),    
+    m_lowerDataBoundary( 0.0 ),
+    m_upperDataBoundary( 0.0 ),
+    m_totalValue       ( 0.0 ),
+    m_maxRow           ( 0 ),
+    m_visibleBounds    ( -1, -1 ),
+    m_showTotalRange   ( true ),
+    m_loggingOn        ( false ),
+    m_fixedColourOn    ( false ),
+    m_chartIsLoading   ( false ),
+    m_snapshotDirty    ( true ),
+    m_visibleDirty     ( true ),
+    m_asyncLayout      ( false ),
+    m_layoutPending    ( false ),
+    m_speculativePending( false ),
+    m_speculative      ( false ),
+    m_layeredRendering ( false ),
+    m_progressive      ( false ),
+    m_backend          ( SCENE_BACKEND ),
+    m_directSelectedRow( -1 ),
+    m_directLegendIndex(),
+    m_cursorNavigation ( false )
+  {
+    m_graphScene->setBackgroundBrush( QBrush( QColor( 245,245,245 ) ) );
+
+    m_graphScene->addItem( m_header );  // takes ownership
+    m_graphScene->addItem( m_xLabel );  // takes ownership
+    m_graphScene->addItem( m_yLabel );  // takes ownership
+
+    m_graphicsView->setScene( m_graphScene );
+    m_graphicsView->setResizeAnchor( QGraphicsView::AnchorViewCenter );
+    m_graphicsView->setHorizontalScrollBarPolicy( Qt::ScrollBarAlwaysOff );
+    m_graphicsView->setVerticalScrollBarPolicy( Qt::ScrollBarAlwaysOff );
+    m_fullQualityHints = m_graphicsView->renderHints();
+
+    /* Convenience mapping. */
+    m_labels.insert( HEADER, m_header );
+    m_labels.insert( YLABEL, m_yLabel );
+    m_labels.insert( XLABEL, m_xLabel );
+
+    m_labelNames.insert( "HEADER", HEADER );
+    m_labelNames.insert( "YLABEL", YLABEL );
+    m_labelNames.insert( "XLABEL", XLABEL );
+
+    m_ingestionTimer->setInterval( 1000/DEFAULT_INGESTION_RATE );
+
+    m_renderTimer->setSingleShot( true );
+
+    /* Progressive slices are run whenever the event loop has nothing else to do. */
+    m_progressiveTimer->setInterval( 0 );
+
+    m_qualityTimer->setSingleShot( true );
+    m_qualityTimer->setInterval( DEFAULT_RESTORE_DELAY );
+
+    m_labelSyncTimer->setSingleShot( true );
+    m_labelSyncTimer->setInterval( LABEL_SYNC_DELAY );
+
+    /* Mouse moves arrive far more often than the display refreshes, hit test at most once per refresh. */
+    m_hoverTimer->setSingleShot( true );
+    m_hoverTimer->setInterval( HOVER_INTERVAL );
+
+    m_hibernateTimer->setSingleShot( true );
+    GobChartsHibernation::registerChart( this );
+  }
+
+  ~GobChartsViewPrivate()
+  {
+    /* The worker thread references m_layoutVersion, make sure it is done before we go. */
+    m_layoutVersion.fetchAndAddOrdered( 1 );
+    m_layoutWatcher->waitForFinished();
+    delete m_layoutWatcher;
+
+    m_speculativeWatcher->waitForFinished();
+    delete m_speculativeWatcher;
+
+    m_ingestionTimer->stop();
+    delete m_ingestionTimer;
+
+    m_renderTimer->stop();
+    delete m_renderTimer;
+
+    cancelProgressiveBuild();
+    delete m_progressiveTimer;
+
+    m_qualityTimer->stop();
+    delete m_qualityTimer;
+
+    m_labelSyncTimer->stop();
+    delete m_labelSyncTimer;
+
+    m_hoverTimer->stop();
+    delete m_hoverTimer;
+
+    m_hibernateTimer->stop();
+    delete m_hibernateTimer;
+    GobChartsHibernation::unregisterChart( this );
+
+    /* Strategies may have items of their own in the scene. */
+    delete m_strategy;
+
+    m_graphItems->removeItemsFromScene( m_graphScene );
+    m_grid->removeGridFromScene( m_graphScene );
+
+    delete m_graphicsView;
+    delete m_graphScene;
+    delete m_graphItems;
+    delete m_grid;
+    delete m_validItems;
+  }
+
+  GobChartsView       *m_gobChartsView;       // pointer to the object to which we have friend access to
+  QGraphicsView       *m_graphicsView;
+  QGraphicsScene      *m_graphScene;
+  GobChartsTextItem   *m_header;
+  GobChartsTextItem   *m_yLabel;
+  GobChartsTextItem   *m_xLabel;
+  GobChartsViewStrategy *m_strategy;         // everything specific to the current chart type
+  GobChartsGraphItems *m_graphItems;
+  GobChartsGrid       *m_grid;
+  GobChartsValidItems *m_validItems;
+  QFutureWatcher< GobChartsGeometry > *m_layoutWatcher;
+  QFutureWatcher< QList< GobChartsGeometry > > *m_speculativeWatcher;
+  QMap< GobChartsType, GobChartsGeometry > m_speculativeLayouts;   // ready-made layouts for the other chart types
+  qint64               m_speculativeMemory;   // bytes
+  qint64               m_speculativeBudget;   // bytes
+  GobChartsDataSnapshot m_snapshot;           // the data last handed to the layout functions
+  GobChartsGeometry    m_geometry;            // the geometry currently displayed
+  qint64               m_geometryMemory;      // GeometryMemory( m_geometry ), bytes
+  QAtomicInt           m_layoutVersion;       // version of the latest layout request
+  GobChartsIngestionQueue *m_ingestionQueue;  // queue owned elsewhere
+  QTimer              *m_ingestionTimer;
+  QVector< GobChartsSample > m_samples;       // re-used between drains to avoid reallocation
+  QTimer              *m_renderTimer;
+  GobChartsFrameClock  m_frameClock;          // time base, frame window and statistics of the render scheduler
+  bool                 m_redrawPending;
+  int                  m_updateDepth;         // nesting level of beginUpdate() calls
+  bool                 m_updateDirty;         // a redraw was requested during the current transaction
+  bool                 m_hiddenDirty;         // a redraw was requested while the chart was hidden or minimised
+  QTimer              *m_hibernateTimer;      // started when the chart is hidden
+  int                  m_hibernationTimeout;  // milliseconds, 0 if idle charts don't hibernate
+  GobChartsHibernationStats m_hibernationStats;
+  bool                 m_hibernating;         // the scene memory was released, the chart is rebuilt when shown
+  QTimer              *m_progressiveTimer;
+  QGraphicsPathItem   *m_previewItem;         // coarse preview shown while the items are built progressively
+  QGraphicsRectItem   *m_rangeItem;           // range selection overlay (scene backend)
+  QRectF               m_rangeRect;           // range selection overlay in scene coordinates, null if none
+  QRubberBand         *m_rubberBand;          // owned by the graphics view's viewport
+  QPoint               m_rubberBandOrigin;
+  bool                 m_rubberBandArmed;     // the left mouse button went down where a drag may start a range selection
+  QTimer              *m_hoverTimer;          // throttles hover hit tests
+  QGraphicsPathItem   *m_hoverItem;           // hover outline (scene backend)
+  QPainterPath         m_hoverPath;           // hover outline in scene coordinates
+  QPoint               m_hoverPos;            // last known mouse position (viewport coordinates)
+  int                  m_hoverIndex;          // index into m_geometry.items of the hovered item, -1 if none
+  QRectF               m_scrollContentRect;   // scrolling mode: the rectangle all bars are laid out across, m_geometry only holds the visible ones
+  QHash< QString, int > m_scrollLegendIndex;  // scrolling mode: legend text to snapshot position
+  qreal                m_minimumBarWidth;     // scrolling mode
+  bool                 m_scrolling;
+  bool                 m_scrollRangeUpdate;   // the scroll bar range is being updated, ignore the resulting scrolls
+  bool                 m_pyramidDirty;        // the snapshot's data or visible positions changed since the pyramid was built
+  int                  m_zoomFirst;           // first position of the zoomed range, -1 if not zoomed
+  int                  m_zoomLast;
+  QPoint               m_panOrigin;           // viewport position at which panning started
+  int                  m_panFirst;            // first position of the zoomed range when panning started
+  bool                 m_panning;
+  int                  m_progressiveNext;     // index into m_geometry.items of the next item to build
+  int                  m_timeSlice;           // milliseconds per progressive slice
+  QTimer              *m_qualityTimer;        // restores full quality once interaction stops
+  GobChartsQuality     m_interactiveQuality;
+  GobChartsQuality     m_renderQuality;       // the tier currently in use
+  QPainter::RenderHints m_fullQualityHints;   // the graphics view's render hints at FULL_QUALITY
+  QTimer              *m_labelSyncTimer;      // defers broadcasting label details while the user is typing
+  QElapsedTimer        m_keystrokeClock;      // started by the first label keystroke not yet painted
+  bool                 m_latencyPending;
+  GobChartsLabel       m_selectedLabel;       // to keep track of the selected text item to ensure the correct item receives the keyboard input
+  QRectF               m_innerSceneRectF;
+  QColor               m_fixedColour;
+  QString              m_legendText;
+  qreal                m_leftRightMargin;
+  qreal                m_topBottomMargin;
+  qreal                m_maxValue;
+  qreal                m_lowerDataBoundary;
+  qreal                m_upperDataBoundary;
+  qreal                m_totalValue;
+  int                  m_maxRow;              // the last row containing valid items
+  QPair< int, int >    m_visibleBounds;       // value-sorted index bounds of the allowed data range
+  bool                 m_showTotalRange;
+  bool                 m_loggingOn;
+  bool                 m_fixedColourOn;
+  bool                 m_chartIsLoading;
+  bool                 m_snapshotDirty;       // valid items changed since the last snapshot
+  bool                 m_visibleDirty;        // valid items or allowed data range changed since the snapshot's visible positions were taken
+  bool                 m_asyncLayout;
+  bool                 m_layoutPending;       // a newer request arrived while a layout was running
+  bool                 m_speculativePending;
+  bool                 m_speculative;
+  bool                 m_layeredRendering;
+  bool                 m_progressive;
+  GobChartsBackend     m_backend;
+  int                  m_directSelectedRow;   // DIRECT_BACKEND only, -1 if nothing is selected
+  QHash< QString, int > m_directLegendIndex;  // DIRECT_BACKEND only, legend text to index into m_geometry.items
+  bool                 m_cursorNavigation;    // the current key press is being handled by QAbstractItemView
+
+  /* Convenience mappings to rid us of all the "switch" statements required otherwise. */
+  QMap< GobChartsLabel, GobChartsTextItem* > m_labels;
+  QMap< QString,        GobChartsLabel     > m_labelNames;
+};
+
+
+/*------------------------------- MEMBER FUNCTIONS -------------------------------*/
+
+GobChartsView::GobChartsView( QWidget *parent ) :
+  QAbstractItemView( parent ),
+  m_private        ( new GobChartsViewPrivate( this ) )
+{
+  setHorizontalScrollBarPolicy( Qt::ScrollBarAlwaysOff );
+  setVerticalScrollBarPolicy( Qt::ScrollBarAlwaysOff );
+
+  m_private->m_strategy = GobChartsFactory::getInstance()->createStrategy( BAR, this );
+  m_private->calculateGeometries();
+
+  /* Labels. */
+  connect( m_private->m_header, SIGNAL( identity           ( const QString& ) ),
+                          this, SLOT  ( setSelectedTextItem( const QString& ) ) );
+
+  connect( m_private->m_xLabel, SIGNAL( identity           ( const QString& ) ),
+                          this, SLOT  ( setSelectedTextItem( const QString& ) ) );
+
+  connect( m_private->m_yLabel, SIGNAL( identity           ( const QString& ) ),
+                          this, SLOT  ( setSelectedTextItem( const QString& ) ) );
+
+  /* Debug logging. */
+  connect( m_private->m_graphItems, SIGNAL( lastDebugLogMsg( QString ) ), this, SLOT( debugLog( QString ) ) );
+  connect( m_private->m_grid,       SIGNAL( lastDebugLogMsg( QString ) ), this, SLOT( debugLog( QString ) ) );
+
+  /* Asynchronous layout. */
+  connect( m_private->m_layoutWatcher, SIGNAL( finished() ), this, SLOT( layoutFinished() ) );
+  connect( m_private->m_speculativeWatcher, SIGNAL( finished() ), this, SLOT( speculativeLayoutsFinished() ) );
+
+  /* Real-time ingestion. */
+  connect( m_private->m_ingestionTimer, SIGNAL( timeout() ), this, SLOT( drainIngestionQueue() ) );
+
+  /* Render scheduler. */
+  connect( m_private->m_renderTimer, SIGNAL( timeout() ), this, SLOT( renderScheduledFrame() ) );
+
+  /* Progressive rendering. */
+  connect( m_private->m_progressiveTimer, SIGNAL( timeout() ), this, SLOT( buildNextSlice() ) );
+
+  /* Level of detail. */
+  connect( m_private->m_qualityTimer, SIGNAL( timeout() ), this, SLOT( restoreFullQuality() ) );
+
+  /* Label editing. */
+  connect( m_private->m_labelSyncTimer, SIGNAL( timeout() ), this, SLOT( syncLabelDetails() ) );
+
+  /* Hover feedback. */
+  connect( m_private->m_hoverTimer, SIGNAL( timeout() ), this, SLOT( updateHover() ) );
+
+  /* Hibernation. */
+  connect( m_private->m_hibernateTimer, SIGNAL( timeout() ), this, SLOT( hibernate() ) );
+
+  QVBoxLayout *layout = new QVBoxLayout;
+  layout->addWidget( m_private->m_graphicsView );
+  setLayout( layout );
+
+  setViewport( m_private->m_graphicsView );
+
+  /* The DIRECT_BACKEND takes over painting from the graphics view, range selection is handled
+    before mouse events reach the graphics view. */
+  m_private->m_graphicsView->viewport()->installEventFilter( this );
+  m_private->m_rubberBand = new QRubberBand( QRubberBand::Rectangle, m_private->m_graphicsView->viewport() );
+  m_private->m_graphicsView->viewport()->setMouseTracking( true );
+}
+
+/*--------------------------------------------------------------------------------*/
+
+GobChartsView::~GobChartsView() 
+{
+  delete m_private;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsView::setLabelDetails( GobChartsLabel label, const QString &text, const QFont &font, const QColor &colour, Qt::Alignment align )
+{
+  if( m_private->m_labels.contains( label ) )
+  {
+    /* Values returned from the map aren't modifiable by default. */
+    const_cast< GobChartsTextItem* >( m_private->m_labels.value( label ) )->setDetails( text, font, colour, align );
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
 
 void GobChartsView::requestLabelDetails( GobChartsLabel label )
 {
-  if( m_private->m_labels.contains( label ) )
+  if( m_private->m_labels.contains( label ) )
+  {
+    m_private->setSelectedLabel( label );
+    emit emitLabelDetails( label, m_private->labelText( label ), m_private->labelFont( label ), m_private->labelColour( label ), m_private->labelAlignment( label ) );
+
+    m_private->m_graphScene->clearFocus();
+    m_private->m_graphScene->setFocusItem( m_private->labelGraphicsItem( label ) );
+  }
+  else
+  {
+    m_private->setSelectedLabel( NONE );
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsView::setSelectedTextItem( const QString &itemName )
+{
+  requestLabelDetails( m_private->m_labelNames.value( itemName ) );
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsView::setGridLineStyle( Qt::PenStyle style )
+{
+  m_private->m_grid->setGridLineStyle( style );
+  m_private->scheduleRedraw();
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsView::setHorizontalGridLines( bool set, int number )
+{
+  m_private->m_grid->setHorizontalGridLines( set, number );
+  m_private->scheduleRedraw();
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsView::setVerticalGridLines( bool set, int number )
+{
+  m_private->m_grid->setVerticalGridLines( set, number );
+  m_private->scheduleRedraw();
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsView::setGridColour( QColor colour )
+{
+  m_private->m_grid->setGridColour( colour );
+  m_private->scheduleRedraw();
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsView::drawChart()
+{
+  if( m_private->m_updateDepth > 0 )
+  {
+    m_private->m_updateDirty = true;    // endUpdate() redraws
+    return;
+  }
+
+  if( m_private->deferWhileHidden() )
+  {
+    return;
+  }
+
+  if( model() || isStreaming() )
+  {
+    m_private->calculateGeometries();
+
+    if( m_private->m_strategy->needsGrid() )
+    {
+      m_private->m_grid->constructGrid();                               // only rebuilds the paths if anything changed
+      m_private->m_grid->addGridToScene( m_private->m_graphScene );     // does nothing if already added
+    }
+    else
+    {
+      m_private->m_grid->removeGridFromScene( m_private->m_graphScene );  // does nothing if not added
+    }
+
+    if( isStreaming() )
+    {
+      /* Streamed samples replace the model's data, also make sure no pending layout brings it back. */
+      m_private->m_layoutVersion.fetchAndAddOrdered( 1 );
+
+      if( !m_private->m_geometry.items.isEmpty() )
+      {
+        applyGeometry( GobChartsGeometry() );
+      }
+
+      m_private->m_strategy->relayoutStream();
+      return;
+    }
+
+    const GobChartsDataSnapshot &snapshot = m_private->dataSnapshot();
+
+    if( m_private->isScrolling() )
+    {
+      /* Only the bars in the visible window are ever laid out (see scrollContentsBy()), the legend lists them all. */
+      m_private->m_scrollContentRect = m_private->layoutRect();
+      m_private->updateScrollRange( qCeil( m_private->m_scrollContentRect.width() - m_private->m_innerSceneRectF.width() ) );
+      m_private->updateScrollLegend();
+      applyGeometry( m_private->scrollWindow() );
+      return;
+    }
+
+    if( m_private->m_speculative )
+    {
+      m_private->startSpeculativeLayouts();
+    }
+
+    if( m_private->m_asyncLayout )
+    {
+      /* The current items remain on display until the new geometry is ready. */
+      m_private->startLayout();
+    }
+    else
+    {
+      applyGeometry( GobChartsLayout::calculate( m_private->m_strategy->chartType(), snapshot, m_private->layoutRect() ) );
+    }
+  }
+  else
+  {
+    m_private->emitDebugLogMsg( tr( "GobChartsView::drawChart# No valid data model set." ) );
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsView::applyGeometry( const GobChartsGeometry &geometry )
+{
+  /* Whatever is still being built belongs to an older request. */
+  m_private->cancelProgressiveBuild();
+
+  /* Scrolling charts only ever display the visible window and keep the legend of all their bars. */
+  bool scrolling = m_private->isScrolling();
+
+  if( !scrolling )
+  {
+    m_private->updateScrollRange( 0 );
+  }
+
+  m_private->m_graphItems->removeItemsFromScene( m_private->m_graphScene );
+  m_private->m_graphItems->deleteItems();
+  m_private->clearRange();
+  m_private->clearHover();
+  m_private->m_geometry       = geometry;
+  m_private->m_geometryMemory = GeometryMemory( geometry );
+  m_private->updateSceneMemory();
+
+  if( !scrolling )
+  {
+    emit clearLegend();
+  }
+
+  if( geometry.items.isEmpty() )
+  {
+    m_private->emitDebugLogMsg( tr( "GobChartsView::applyGeometry# No valid items." ) );
+  }
+
+  m_private->m_directSelectedRow = -1;
+  m_private->m_directLegendIndex.clear();
+
+  if( m_private->isDirect() )
+  {
+    /* Nothing to create, the items are painted from the geometry. */
+    for( int i = 0; i < geometry.items.size(); i++ )
+    {
+      const GobChartsGeometryItem &geometryItem = geometry.items.at( i );
+
+      if( !scrolling )
+      {
+        emit createLegendItem( geometryItem.colour, geometryItem.legendText );
+      }
+
+      /* Legend lookups find the first item with a given text. */
+      if( !m_private->m_directLegendIndex.contains( geometryItem.legendText ) )
+      {
+        m_private->m_directLegendIndex.insert( geometryItem.legendText, i );
+      }
+    }
+
+    m_private->m_graphicsView->viewport()->update();
+    return;
+  }
+
+  if( m_private->m_progressive && geometry.items.size() >= PROGRESSIVE_THRESHOLD )
+  {
+    m_private->showPreview( geometry );
+    m_private->m_progressiveTimer->start();
+    return;
+  }
+
+  for( int i = 0; i < geometry.items.size(); i++ )
+  {
+    /* Out of frame budget, the progressive builder creates the remaining items in later time slices. */
+    if( ( i > 0 ) && ( i % BUDGET_CHECK_STEP == 0 ) && m_private->m_frameClock.budgetExceeded() )
+    {
+      m_private->m_progressiveNext = i;
+      m_private->m_progressiveTimer->start();
+      m_private->m_frameClock.countTruncatedFrame();
+      m_private->emitDebugLogMsg( tr( "GobChartsView::applyGeometry# Frame budget exceeded, deferring [%1] item(s)." ).arg( geometry.items.size() - i ) );
+      break;
+    }
+
+    const GobChartsGeometryItem &geometryItem = geometry.items.at( i );
+
+    QGraphicsItem *item = m_private->m_strategy->createGraphicsItem( geometryItem );
+    addToGraphItemsContainer( model()->index( geometryItem.row, VALUE ), item, geometryItem.legendText );
+
+    if( !scrolling )
+    {
+      emit createLegendItem( geometryItem.colour, geometryItem.legendText );
+    }
+  }
+
+  m_private->m_graphItems->addItemsToScene( m_private->m_graphScene );
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsView::buildNextSlice()
+{
+  const QVector< GobChartsGeometryItem > &items = m_private->m_geometry.items;
+
+  QElapsedTimer slice;
+  slice.start();
+
+  /* At least one item per slice, however small the budget. */
+  while( m_private->m_progressiveNext < items.size() )
+  {
+    const GobChartsGeometryItem &geometryItem = items.at( m_private->m_progressiveNext++ );
+
+    QGraphicsItem *item = m_private->m_strategy->createGraphicsItem( geometryItem );
+    addToGraphItemsContainer( model()->index( geometryItem.row, VALUE ), item, geometryItem.legendText );
+
+    if( !m_private->isScrolling() )
+    {
+      emit createLegendItem( geometryItem.colour, geometryItem.legendText );
+    }
+
+    if( item )
+    {
+      m_private->m_graphScene->addItem( item );
+    }
+
+    if( slice.elapsed() >= m_private->m_timeSlice )
+    {
+      break;
+    }
+  }
+
+  if( m_private->m_progressiveNext >= items.size() )
+  {
+    m_private->cancelProgressiveBuild();   // done, removes the preview
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsView::setInteractiveQuality( GobChartsQuality quality, int restoreDelay )
+{
+  m_private->m_interactiveQuality = quality;
+  m_private->m_qualityTimer->setInterval( qMax( 0, restoreDelay ) );
+
+  if( quality == FULL_QUALITY && m_private->m_renderQuality != FULL_QUALITY )
   {
-    m_private->m_selectedLabel = label;
-    emit emitLabelDetails( label, m_private->labelText( label ), m_private->labelFont( label ), m_private->labelColour( label ), m_private->labelAlignment( label ) );
+    m_private->m_qualityTimer->stop();
+    restoreFullQuality();
+  }
+}
 
-    m_private->m_graphScene->clearFocus();
-    m_private->m_graphScene->setFocusItem( m_private->labelGraphicsItem( label ) );
+/*--------------------------------------------------------------------------------*/
+
+GobChartsQuality GobChartsView::renderQuality() const
+{
+  return m_private->m_renderQuality;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsView::restoreFullQuality()
+{
+  GobChartsQuality previous = m_private->m_renderQuality;
+  m_private->m_renderQuality = FULL_QUALITY;
+  m_private->applyRenderQuality();
+
+  /* Draft items lack their gradients, those can only be restored by re-creating the items (direct
+    painting picks up the new tier with the next paint event). */
+  if( previous == DRAFT_QUALITY && !m_private->isDirect() && !isStreaming() )
+  {
+    m_private->scheduleRedraw();
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsView::setProgressiveRendering( bool progressive, int timeSlice )
+{
+  m_private->m_progressive = progressive;
+  m_private->m_timeSlice   = qMax( 1, timeSlice );
+
+  /* Finish the current build straight away. */
+  while( !progressive && m_private->m_progressiveTimer->isActive() )
+  {
+    buildNextSlice();
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsView::layoutFinished()
+{
+  GobChartsGeometry geometry = m_private->m_layoutWatcher->result();
+
+  if( m_private->isCurrent( geometry ) && model() )
+  {
+    applyGeometry( geometry );
   }
   else
   {
-    m_private->m_selectedLabel = NONE;
+    m_private->emitDebugLogMsg( tr( "GobChartsView::layoutFinished# Discarding superseded layout." ) );
+  }
+
+  GobChartsHibernation::enforceMemoryBudget();
+
+  if( m_private->m_layoutPending )
+  {
+    m_private->startLayout();
   }
 }
 
 /*--------------------------------------------------------------------------------*/
 
-void GobChartsView::setSelectedTextItem( const QString &itemName )
+void GobChartsView::speculativeLayoutsFinished()
 {
-  requestLabelDetails( m_private->m_labelNames.value( itemName ) );
+  /* Releasing the result (below) reports an empty, finished future. */
+  if( m_private->m_speculativeWatcher->future().resultCount() == 0 )
+  {
+    return;
+  }
+
+  if( m_private->m_speculativePending )
+  {
+    m_private->startSpeculativeLayouts();
+    return;
+  }
+
+  /* Layouts of a hibernating chart were calculated from the released snapshot. */
+  if( !m_private->m_hibernating )
+  {
+    foreach( const GobChartsGeometry &geometry, m_private->m_speculativeWatcher->result() )
+    {
+      m_private->cacheSpeculativeLayout( geometry );
+    }
+  }
+
+  /* Otherwise the layouts that didn't fit into the cache stay in memory until the next run. */
+  m_private->m_speculativeWatcher->setFuture( QFuture< QList< GobChartsGeometry > >() );
 }
 
 /*--------------------------------------------------------------------------------*/
 
-void GobChartsView::setGridLineStyle( Qt::PenStyle style )
+void GobChartsView::setSpeculativeLayouts( bool speculative, qint64 memoryBudget )
 {
-  m_private->m_grid->setGridLineStyle( style );
-  drawChart();
+  m_private->m_speculative       = speculative;
+  m_private->m_speculativeBudget = qMax( qint64( 0 ), memoryBudget );
+
+  if( !speculative )
+  {
+    m_private->clearSpeculativeLayouts();
+  }
 }
 
 /*--------------------------------------------------------------------------------*/
 
-void GobChartsView::setHorizontalGridLines( bool set, int number )
+qint64 GobChartsView::speculativeLayoutMemory() const
 {
-  m_private->m_grid->setHorizontalGridLines( set, number );
-  drawChart();
+  return m_private->m_speculativeMemory;
 }
 
 /*--------------------------------------------------------------------------------*/
 
-void GobChartsView::setVerticalGridLines( bool set, int number )
+void GobChartsView::setHibernationTimeout( int milliseconds )
 {
-  m_private->m_grid->setVerticalGridLines( set, number );
-  drawChart();
+  m_private->m_hibernationTimeout = qMax( 0, milliseconds );
+
+  if( m_private->m_hibernationTimeout == 0 )
+  {
+    m_private->m_hibernateTimer->stop();
+  }
+  else if( !m_private->isOnScreen() && !m_private->m_hibernating )
+  {
+    m_private->m_hibernateTimer->start( m_private->m_hibernationTimeout );
+  }
 }
 
 /*--------------------------------------------------------------------------------*/
 
-void GobChartsView::setGridColour( QColor colour )
+void GobChartsView::setHibernationMemoryBudget( qint64 bytes )
 {
-  m_private->m_grid->setGridColour( colour );
-  drawChart();
+  GobChartsHibernation::setMemoryBudget( bytes );
+  GobChartsHibernation::enforceMemoryBudget();
 }
 
 /*--------------------------------------------------------------------------------*/
 
-void GobChartsView::drawChart()
+GobChartsHibernationStats GobChartsView::hibernationStats() const
+{
+  GobChartsHibernationStats stats = m_private->m_hibernationStats;
+  stats.hibernating = m_private->m_hibernating;
+  return stats;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsView::hibernate()
 {
-  if( model() )
+  if( !m_private->hibernate() )
   {
-    m_private->calculateGeometries();
+    m_private->emitDebugLogMsg( tr( "GobChartsView::hibernate# Charts that are shown, streaming or already hibernating are left as is." ) );
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsView::setAsynchronousLayout( bool async )
+{
+  m_private->m_asyncLayout = async;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsView::setIngestionQueue( GobChartsIngestionQueue *queue )
+{
+  m_private->m_ingestionQueue = queue;
+
+  if( queue )
+  {
+    m_private->m_ingestionTimer->start();
+  }
+  else
+  {
+    m_private->m_ingestionTimer->stop();
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsView::setIngestionRate( int framesPerSecond )
+{
+  if( framesPerSecond > 0 )
+  {
+    m_private->m_ingestionTimer->setInterval( 1000/framesPerSecond );
+  }
+  else
+  {
+    m_private->emitDebugLogMsg( tr( "GobChartsView::setIngestionRate# Invalid rate [%1] provided." ).arg( framesPerSecond ) );
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsView::drainIngestionQueue()
+{
+  if( !m_private->m_ingestionQueue || !model() )
+  {
+    return;
+  }
+
+  m_private->m_samples.resize( 0 );
+
+  if( m_private->m_ingestionQueue->drain( m_private->m_samples ) == 0 )
+  {
+    return;
+  }
+
+  /* Only the latest value per row is of any interest. */
+  QMap< int, qreal > latest;
+
+  foreach( const GobChartsSample &sample, m_private->m_samples )
+  {
+    latest.insert( sample.row, sample.value );
+  }
+
+  /* We don't want to execute the functionality in dataChanged() for every sample. */
+  m_private->m_chartIsLoading = true;
 
-    m_private->m_graphItems->removeItemsFromScene( m_private->m_graphScene );
-    m_private->m_graphItems->deleteItems();
+  int rowCount = m_private->m_maxRow;
+  QMap< int, qreal >::const_iterator it = latest.constBegin();
 
-    if( needsGrid() )
+  for( ; it != latest.constEnd(); ++it )
+  {
+    if( it.key() >= 0 && it.key() < model()->rowCount() )
     {
-      m_private->m_grid->removeGridFromScene( m_private->m_graphScene );
-      m_private->m_grid->constructGrid();                               // delete old lines and generate new ones
+      model()->setData( model()->index( it.key(), VALUE ), it.value() );
+      rowCount = qMax( rowCount, it.key() + 1 );
+    }
+    else
+    {
+      m_private->emitDebugLogMsg( tr( "GobChartsView::drainIngestionQueue# Sample for row [%1] is outside the data model." ).arg( it.key() + 1 ) );
+    }
+  }
+
+  m_private->m_chartIsLoading = false;
+  m_private->calculateActiveTotals( rowCount );
+  m_private->interactionStarted();
+  m_private->scheduleRedraw();
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsView::setMaximumFrameRate( int framesPerSecond )
+{
+  if( framesPerSecond < 0 )
+  {
+    m_private->emitDebugLogMsg( tr( "GobChartsView::setMaximumFrameRate# Invalid rate [%1] provided." ).arg( framesPerSecond ) );
+    return;
+  }
+
+  m_private->m_frameClock.setMaximumFrameRate( framesPerSecond );
+
+  /* Don't leave a request hanging when the cap is removed. */
+  if( !m_private->m_frameClock.isCapped() && m_private->m_redrawPending )
+  {
+    m_private->m_renderTimer->stop();
+    m_private->renderFrame();
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsView::setFrameBudget( int milliseconds )
+{
+  m_private->m_frameClock.setFrameBudget( milliseconds );
+}
+
+/*--------------------------------------------------------------------------------*/
+
+GobChartsRenderStats GobChartsView::renderStats() const
+{
+  return m_private->m_frameClock.stats();
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsView::resetRenderStats()
+{
+  m_private->m_frameClock.resetStats();
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsView::beginUpdate()
+{
+  m_private->m_updateDepth++;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsView::endUpdate()
+{
+  if( m_private->m_updateDepth <= 0 )
+  {
+    m_private->emitDebugLogMsg( tr( "GobChartsView::endUpdate# No matching call to beginUpdate()." ) );
+    return;
+  }
+
+  m_private->m_updateDepth--;
+
+  if( m_private->m_updateDepth == 0 && m_private->m_updateDirty )
+  {
+    m_private->m_updateDirty = false;
+    m_private->scheduleRedraw();
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsView::renderScheduledFrame()
+{
+  if( m_private->m_redrawPending )
+  {
+    m_private->renderFrame();
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsView::setLayeredRendering( bool layered )
+{
+  QGraphicsItem::CacheMode mode = layered ? QGraphicsItem::DeviceCoordinateCache : QGraphicsItem::NoCache;
+
+  m_private->m_layeredRendering = layered;
+  m_private->m_graphicsView->setCacheMode( layered ? QGraphicsView::CacheBackground : QGraphicsView::CacheNone );
+  m_private->m_grid->setCacheMode( mode );
+
+  foreach( GobChartsTextItem *label, m_private->m_labels )
+  {
+    label->setCacheMode( mode );
+  }
+
+  m_private->scheduleRedraw();
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsView::setRenderBackend( GobChartsBackend backend )
+{
+  if( backend != m_private->m_backend )
+  {
+    m_private->m_backend = backend;
+
+    /* Re-create (or drop) the graphics items for the current geometry. */
+    if( model() )
+    {
+      applyGeometry( m_private->m_geometry );
+    }
+
+    m_private->m_graphicsView->viewport()->update();
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsView::setChartType( GobChartsType type )
+{
+  if( type == m_private->m_strategy->chartType() )
+  {
+    return;
+  }
+
+  GobChartsViewStrategy *strategy = GobChartsFactory::getInstance()->createStrategy( type, this );
+
+  if( !strategy )
+  {
+    m_private->emitDebugLogMsg( tr( "GobChartsView::setChartType# Unknown chart type [%1]." ).arg( static_cast< int >( type ) ) );
+    return;
+  }
+
+  /* Only the previous type's items go, the data, labels and scene stay.  Make sure that a layout
+    still running for the previous type is discarded when it finishes. */
+  m_private->m_layoutVersion.fetchAndAddOrdered( 1 );
+
+  /* Keep the current layout around for switching back.  Scrolling BAR charts only ever display part of
+    their layout, which is of no use to a speculative cache. */
+  bool scrollingBar = m_private->m_scrolling && ( type == BAR );
+  GobChartsGeometry cached = m_private->m_speculativeLayouts.value( type );
+  bool useCached = m_private->m_speculative && !isStreaming() && !scrollingBar && m_private->isSpeculativeCurrent( cached ) && model();
+
+  if( m_private->m_speculative && !isStreaming() && !m_private->isScrolling() )
+  {
+    m_private->cacheSpeculativeLayout( m_private->m_geometry );
+  }
+
+  delete m_private->m_strategy;    // removes its streamed items (if any) from the scene
+  m_private->m_strategy = strategy;
+
+  /* Axis labels make no sense without a grid (e.g. PIE charts). */
+  m_private->m_yLabel->setVisible( strategy->needsGrid() );
+  m_private->m_xLabel->setVisible( strategy->needsGrid() );
+
+  if( useCached )
+  {
+    /* The data and inner rectangle haven't changed since the layout was calculated, all that remains
+      to be done is to create the items (and update the grid). */
+    if( strategy->needsGrid() )
+    {
+      m_private->m_grid->constructGrid();
       m_private->m_grid->addGridToScene( m_private->m_graphScene );
     }
+    else
+    {
+      m_private->m_grid->removeGridFromScene( m_private->m_graphScene );
+    }
+
+    applyGeometry( cached );
+  }
+  else
+  {
+    applyGeometry( GobChartsGeometry() );
+    m_private->scheduleRedraw();
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+
+GobChartsType GobChartsView::chartType() const
+{
+  return m_private->m_strategy->chartType();
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsView::setStreamingWindow( int windowSize, GobChartsStreamMode mode )
+{
+  m_private->m_strategy->setStreamingWindow( windowSize, mode );
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsView::appendStreamSample( qreal value )
+{
+  m_private->m_strategy->appendStreamSample( value );
+}
+
+/*--------------------------------------------------------------------------------*/
+
+bool GobChartsView::isStreaming() const
+{
+  return m_private->m_strategy->isStreaming();
+}
 
-    GobChartsColours::resetColourIndex();
-    generateGraphicsItems();
+/*--------------------------------------------------------------------------------*/
 
-    m_private->m_graphItems->addItemsToScene( m_private->m_graphScene );
-  }
-  else
-  {
-    m_private->emitDebugLogMsg( tr( "GobChartsView::drawChart# No valid data model set." ) );
-  }
+QGraphicsScene *GobChartsView::chartScene() const
+{
+  return m_private->m_graphScene;
 }
 
 /*--------------------------------------------------------------------------------*/
 
 void GobChartsView::legendItemSelected( const QString &text )
 {
+  /* The legend of a scrolling chart also lists the bars outside the visible window, bring it into view first. */
+  if( m_private->isScrolling() && m_private->m_scrollLegendIndex.contains( text ) )
+  {
+    int row = m_private->m_snapshot.rows.at( m_private->m_scrollLegendIndex.value( text ) );
+    scrollTo( model()->index( row, VALUE ), EnsureVisible );
+  }
+
   QRectF rectF = m_private->m_graphItems->getItemRectF( text );
+  QModelIndex index = m_private->m_graphItems->getModelIndex( text );
+
+  if( m_private->isDirect() )
+  {
+    int i = m_private->directItemForLegend( text );
+    QPointF point = GobChartsLayout::anchorPoint( m_private->m_geometry, i );
+    rectF = QRectF( point, QSizeF( 1, 1 ) );
+    index = ( i >= 0 ) ? model()->index( m_private->m_geometry.items.at( i ).row, VALUE ) : QModelIndex();
+  }
+
   QRect rect = rectF.toRect();
   m_private->m_legendText = text;
 
-  selectionModel()->setCurrentIndex( m_private->m_graphItems->getModelIndex( text ), QItemSelectionModel::NoUpdate );
+  selectionModel()->setCurrentIndex( index, QItemSelectionModel::NoUpdate );
   setSelection( rect, QItemSelectionModel::Select /* this flag isn't actually used */ );
 }
 
@@ -503,7 +2557,7 @@ void GobChartsView::setStateXML( const QDomNode &viewNode, const QDomNode &dataN
 
     /* If the chart is not of a type that can have a grid, then it makes no sense
         to set the x or y labels either (e.g. PIE charts). */
-    if( needsGrid() )
+    if( m_private->m_strategy->needsGrid() )
     {
       m_private->m_yLabel->setVisible( true );
       m_private->m_xLabel->setVisible( true );
@@ -584,7 +2638,7 @@ QString GobChartsView::getStateXML( bool includeData ) const
   xml += m_private->m_xLabel->getStateXML();
   xml += "</XLabel>";
 
-  xml += "<ChartType value=\"" + typeInteger() + "\" />";
+  xml += "<ChartType value=\"" + m_private->m_strategy->typeInteger() + "\" />";
   xml += "</View>";
 
   if( includeData )
@@ -609,14 +2663,7 @@ QString GobChartsView::getStateXML( bool includeData ) const
   categories, so we'll strip this space out to maximise visual effect. */
 qreal GobChartsView::stripSpace( qreal perc ) const
 {
-  if( m_private->m_totalValue > 0.0 )
-  {
-    /* I know, this calculation looks nasty, but it really isn't. */
-    qreal maxStrip = m_private->m_innerSceneRectF.height() - ( ( m_private->m_maxValue/m_private->m_totalValue ) + STRIPSPACE_OFFSET ) * m_private->m_innerSceneRectF.height();
-    return ( perc/( m_private->m_maxValue/m_private->m_totalValue ) ) * maxStrip;
-  }
-
-  return 0;
+  return GobChartsLayout::stripSpace( m_private->m_maxValue, m_private->m_totalValue, m_private->m_innerSceneRectF.height(), perc );
 }
 
 /*--------------------------------------------------------------------------------*/
@@ -634,7 +2681,7 @@ void GobChartsView::setFixedColour( QColor colour )
     m_private->m_fixedColourOn = false;
   }
 
-  drawChart();
+  m_private->scheduleRedraw();
 }
 
 /*--------------------------------------------------------------------------------*/
@@ -642,7 +2689,7 @@ void GobChartsView::setFixedColour( QColor colour )
 void GobChartsView::setRandomColours() 
 {
   m_private->m_fixedColourOn = false;
-  drawChart();
+  m_private->scheduleRedraw();
 }
 
 /*--------------------------------------------------------------------------------*/
@@ -672,10 +2719,24 @@ void GobChartsView::setDebugLoggingOn( bool logging )
 
 void GobChartsView::setAllowedDataRange( qreal  lowerBoundary, qreal  upperBoundary ) 
 {
+  QPair< int, int > bounds = m_private->m_validItems->rangeBounds( lowerBoundary, upperBoundary );
+
   m_private->m_lowerDataBoundary = lowerBoundary;
   m_private->m_upperDataBoundary = upperBoundary;
+
+  /* If the new range selects exactly the same items as the one currently displayed, there
+    is nothing to redraw (this keeps rapid range adjustments cheap). */
+  if( !m_private->m_showTotalRange && bounds == m_private->m_visibleBounds )
+  {
+    return;
+  }
+
   m_private->m_showTotalRange = false;
-  drawChart();
+  m_private->m_visibleBounds  = bounds;
+  m_private->m_visibleDirty   = true;
+
+  emit visibleItemCount( bounds.second - bounds.first );
+  m_private->scheduleRedraw();
 }
 
 /*--------------------------------------------------------------------------------*/
@@ -683,7 +2744,11 @@ void GobChartsView::setAllowedDataRange( qreal  lowerBoundary, qreal  upperBound
 void GobChartsView::setShowTotalRange() 
 {
   m_private->m_showTotalRange = true;
-  drawChart();
+  m_private->m_visibleBounds  = qMakePair( -1, -1 );
+  m_private->m_visibleDirty   = true;
+
+  emit visibleItemCount( nrValidItems() );
+  m_private->scheduleRedraw();
 }
 
 /*--------------------------------------------------------------------------------*/
@@ -702,6 +2767,37 @@ bool GobChartsView::isWithinAllowedRange( qreal value ) const
 
 /*--------------------------------------------------------------------------------*/
 
+QList< int > GobChartsView::visiblePositions() const
+{
+  if( m_private->m_showTotalRange )
+  {
+    QList< int > positions;
+
+    for( int i = 0; i < nrValidItems(); i++ )
+    {
+      positions.append( i );
+    }
+
+    return positions;
+  }
+
+  return m_private->m_validItems->positionsWithinRange( m_private->m_lowerDataBoundary, m_private->m_upperDataBoundary );
+}
+
+/*--------------------------------------------------------------------------------*/
+
+int GobChartsView::nrVisibleItems() const
+{
+  if( m_private->m_showTotalRange )
+  {
+    return nrValidItems();
+  }
+
+  return m_private->m_validItems->nrItemsWithinRange( m_private->m_lowerDataBoundary, m_private->m_upperDataBoundary );
+}
+
+/*--------------------------------------------------------------------------------*/
+
 void GobChartsView::addToGraphItemsContainer( const QModelIndex &valueIndex, QGraphicsItem *item, const QString &legendText )
 {
   m_private->m_graphItems->addItem( valueIndex, item, legendText );
@@ -770,7 +2866,48 @@ void GobChartsView::debugLog( QString msg )
 void GobChartsView::resizeEvent( QResizeEvent *event )
 {
   QAbstractItemView::resizeEvent( event );
-  drawChart();
+  m_private->interactionStarted();
+  m_private->scheduleRedraw();
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsView::showEvent( QShowEvent *event )
+{
+  QAbstractItemView::showEvent( event );
+
+  m_private->m_hibernateTimer->stop();
+
+  /* Keep the list of views ordered from least to most recently shown. */
+  GobChartsHibernation::chartShown( m_private );
+
+  if( m_private->m_hibernating )
+  {
+    m_private->m_hibernating = false;   // m_hiddenDirty is set, the chart is rebuilt below
+    m_private->m_hibernationStats.wakeUps++;
+  }
+
+  /* Everything requested while hidden (or minimised) results in a single redraw. */
+  if( m_private->m_hiddenDirty )
+  {
+    m_private->m_hiddenDirty = false;
+    m_private->scheduleRedraw();
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsView::hideEvent( QHideEvent *event )
+{
+  QAbstractItemView::hideEvent( event );
+
+  if( m_private->m_hibernationTimeout > 0 && !m_private->m_hibernating )
+  {
+    m_private->m_hibernateTimer->start( m_private->m_hibernationTimeout );
+  }
+
+  /* Hidden charts are the ones that may be hibernated to stay within the budget. */
+  GobChartsHibernation::enforceMemoryBudget();
 }
 
 /*--------------------------------------------------------------------------------*/
@@ -783,7 +2920,8 @@ void GobChartsView::dataChanged( const QModelIndex &topLeft, const QModelIndex &
   {
     int rowCount = ( ( bottomRight.row() + 1 ) > m_private->m_maxRow ) ? ( bottomRight.row() + 1 ) : m_private->m_maxRow;
     m_private->calculateActiveTotals( rowCount );
-    drawChart();
+    m_private->interactionStarted();
+    m_private->scheduleRedraw();
   }
 }
 
@@ -808,7 +2946,19 @@ void GobChartsView::rowsAboutToBeRemoved( const QModelIndex &parent, int start,
 /*--------------------------------------------------------------------------------*/
 
 QRect GobChartsView::visualRect( const QModelIndex &index ) const
-{            
+{
+  if( m_private->isDirect() )
+  {
+    int i = m_private->directItemForRow( index.row() );
+
+    if( i >= 0 )
+    {
+      return m_private->m_geometry.items.at( i ).rect.toRect();
+    }
+
+    return m_private->m_graphicsView->rect();
+  }
+
   if( !m_private->m_graphItems->getItemRectF( index ).isNull() )
   {
     QRectF rect = m_private->m_graphItems->getItemRectF( index );
@@ -822,8 +2972,133 @@ QRect GobChartsView::visualRect( const QModelIndex &index ) const
 
 void GobChartsView::scrollTo( const QModelIndex &index, ScrollHint hint )
 {
-  Q_UNUSED( index );
-  Q_UNUSED( hint );
+  /* Outside scrolling mode all items are always visible. */
+  if( !m_private->isScrolling() || !index.isValid() )
+  {
+    return;
+  }
+
+  int position = m_private->positionForRow( index.row() );
+
+  if( position < 0 || !m_private->m_scrollContentRect.isValid() )
+  {
+    return;
+  }
+
+  /* Bar position relative to the start of the scroll range. */
+  const QRectF &contentRect = m_private->m_scrollContentRect;
+  QRectF column = GobChartsLayout::barColumn( m_private->m_snapshot, contentRect, position );
+  qreal left    = column.left() - contentRect.left();
+  qreal right   = column.right() - contentRect.left();
+  qreal width  = m_private->m_innerSceneRectF.width();
+  qreal offset = horizontalScrollBar()->value();
+
+  switch( hint )
+  {
+  case EnsureVisible:
+    if( left < offset )
+    {
+      offset = left;
+    }
+    else if( right > offset + width )
+    {
+      offset = right - width;
+    }
+    break;
+  case PositionAtTop:
+    offset = left;
+    break;
+  case PositionAtBottom:
+    offset = right - width;
+    break;
+  case PositionAtCenter:
+    offset = ( left + right - width )/2;
+    break;
+  }
+
+  if( qRound( offset ) != horizontalScrollBar()->value() )
+  {
+    horizontalScrollBar()->setValue( qRound( offset ) );    // see scrollContentsBy()
+    m_private->selectRow( index.row() );
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsView::scrollContentsBy( int dx, int dy )
+{
+  Q_UNUSED( dx );
+  Q_UNUSED( dy );
+
+  /* Nothing is scrolled as such (the base implementation would scroll the viewport's pixels), the bars
+    that have come into view are laid out and created and those that have left are dropped. */
+  if( m_private->isScrolling() && !m_private->m_scrollRangeUpdate && m_private->m_scrollContentRect.isValid() )
+  {
+    m_private->interactionStarted();
+    applyGeometry( m_private->scrollWindow() );
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsView::setZoomRange( int firstPosition, int lastPosition )
+{
+  int size = nrValidItems();
+
+  if( firstPosition < 0 || lastPosition < firstPosition )
+  {
+    m_private->emitDebugLogMsg( tr( "GobChartsView::setZoomRange# Invalid range [%1 - %2] provided." ).arg( firstPosition ).arg( lastPosition ) );
+    return;
+  }
+
+  /* Zooming all the way out is the same as not being zoomed at all. */
+  if( firstPosition == 0 && lastPosition >= size - 1 )
+  {
+    resetZoom();
+    return;
+  }
+
+  if( firstPosition == m_private->m_zoomFirst && lastPosition == m_private->m_zoomLast )
+  {
+    return;
+  }
+
+  m_private->m_zoomFirst = firstPosition;
+  m_private->m_zoomLast  = lastPosition;
+  m_private->interactionStarted();
+  m_private->scheduleRedraw();
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsView::resetZoom()
+{
+  if( m_private->m_zoomFirst < 0 )
+  {
+    return;
+  }
+
+  m_private->m_zoomFirst = -1;
+  m_private->m_zoomLast  = -1;
+  m_private->scheduleRedraw();    // the pyramid stays if the full range still needs summarising
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsView::setScrollingMode( bool scrolling, qreal minimumBarWidth )
+{
+  if( minimumBarWidth <= 0.0 )
+  {
+    m_private->emitDebugLogMsg( tr( "GobChartsView::setScrollingMode# Invalid bar width [%1] provided." ).arg( minimumBarWidth ) );
+    return;
+  }
+
+  m_private->m_scrolling       = scrolling;
+  m_private->m_minimumBarWidth = minimumBarWidth;
+  m_private->m_scrollContentRect = QRectF();
+
+  setHorizontalScrollBarPolicy( scrolling ? Qt::ScrollBarAsNeeded : Qt::ScrollBarAlwaysOff );
+  m_private->scheduleRedraw();
 }
 
 /*--------------------------------------------------------------------------------*/
@@ -846,6 +3121,12 @@ void GobChartsView::setModel( QAbstractItemModel *model )
 
 QModelIndex GobChartsView::indexAt( const QPoint &point ) const 
 {
+  if( m_private->isDirect() )
+  {
+    int i = GobChartsLayout::hitTest( m_private->m_geometry, point );
+    return ( i >= 0 ) ? model()->index( m_private->m_geometry.items.at( i ).row, VALUE ) : QModelIndex();
+  }
+
   if( m_private->m_graphItems->getModelIndex( m_private->m_graphScene->itemAt( point) ).isValid() )
   {
     return m_private->m_graphItems->getModelIndex( m_private->m_graphScene->itemAt( point ) );
@@ -893,7 +3174,8 @@ QModelIndex GobChartsView::moveCursor( QAbstractItemView::CursorAction cursorAct
     break;
   }
 
-  drawChart();
+  /* Only the highlight moves, there is no need to redraw the chart. */
+  m_private->selectRow( current.row() );
   return current;
 }
 
@@ -901,7 +3183,7 @@ QModelIndex GobChartsView::moveCursor( QAbstractItemView::CursorAction cursorAct
 
 int GobChartsView::horizontalOffset() const 
 {
-  return 0;
+  return m_private->isScrolling() ? horizontalScrollBar()->value() : 0;
 }
 
 /*--------------------------------------------------------------------------------*/
@@ -925,6 +3207,17 @@ void GobChartsView::setSelection( const QRect &rect, QItemSelectionModel::Select
 {
   Q_UNUSED( command );
 
+  m_private->clearRange();
+
+  if( selectionModel() && m_private->m_cursorNavigation )
+  {
+    /* Keyboard navigation, moveCursor() already highlighted the item and "rect" merely
+      spans from the last mouse press to the new current item. */
+    QModelIndex index = model()->index( currentIndex().row(), VALUE, rootIndex() );
+    selectionModel()->select( QItemSelection( index, index ), QItemSelectionModel::ClearAndSelect );
+    return;
+  }
+
   if( selectionModel() )
   {
     int firstRow    = m_private->m_maxRow;
@@ -932,6 +3225,32 @@ void GobChartsView::setSelection( const QRect &rect, QItemSelectionModel::Select
     int firstColumn = 1;
     int lastColumn  = 0;
 
+    if( m_private->isDirect() )
+    {
+      int i = GobChartsLayout::hitTest( m_private->m_geometry, QRectF( rect ).center() );
+
+      if( i >= 0 )
+      {
+        const GobChartsGeometryItem &item = m_private->m_geometry.items.at( i );
+        QModelIndex index = model()->index( item.row, VALUE, rootIndex() );
+
+        /* Mimic GobChartsGraphItems::setSelected, which toggles the highlight. */
+        m_private->m_directSelectedRow = ( m_private->m_directSelectedRow == item.row ) ? -1 : item.row;
+        m_private->m_legendText = item.legendText;
+        emit highLightLegendItem( m_private->m_legendText );
+
+        selectionModel()->select( QItemSelection( index, index ), QItemSelectionModel::ClearAndSelect );
+      }
+      else
+      {
+        m_private->m_directSelectedRow = -1;
+        selectionModel()->select( QItemSelection(), QItemSelectionModel::ClearAndSelect );
+      }
+
+      m_private->m_graphicsView->viewport()->update();
+      return;
+    }
+
     QList< QGraphicsItem* > itemList = m_private->m_graphScene->items( rect );
 
     /* We don't need or want multiple selections to be made. */
@@ -978,44 +3297,98 @@ void GobChartsView::setSelection( const QRect &rect, QItemSelectionModel::Select
 
 void GobChartsView::mousePressEvent( QMouseEvent *event ) 
 {
+  m_private->interactionStarted();
   QAbstractItemView::mousePressEvent( event );
-  m_private->m_selectedLabel = NONE;          // reset if selected item isn't a label or header
+  m_private->setSelectedLabel( NONE );        // reset if selected item isn't a label or header
 }
 
 /*--------------------------------------------------------------------------------*/
 
 void GobChartsView::keyPressEvent( QKeyEvent *event ) 
 {
-  if( m_private->m_selectedLabel == HEADER )
-  {
-    m_private->m_header->receiveKeyEvent( event );          // forward event to header
-    requestLabelDetails( HEADER );
-  }
-  else if( m_private->m_selectedLabel == XLABEL )
-  {
-    m_private->m_xLabel->receiveKeyEvent( event );          // forward event to y label
-    requestLabelDetails( XLABEL );
-  }
-  else if( m_private->m_selectedLabel == YLABEL )
+  if( m_private->m_labels.contains( m_private->m_selectedLabel ) )
   {
-    m_private->m_yLabel->receiveKeyEvent( event );          // forward event to x label
-    requestLabelDetails( YLABEL );
+    if( !m_private->m_latencyPending )
+    {
+      m_private->m_keystrokeClock.start();
+      m_private->m_latencyPending = true;
+    }
+
+    /* Forward the event to the header or label, which repaints itself.  Updating the tools widget is
+      comparatively expensive and is postponed until the user pauses typing. */
+    m_private->m_labels.value( m_private->m_selectedLabel )->receiveKeyEvent( event );
+    m_private->m_labelSyncTimer->start();
   }
   else
   {
+    m_private->m_cursorNavigation = true;
     QAbstractItemView::keyPressEvent( event );
+    m_private->m_cursorNavigation = false;
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsView::syncLabelDetails()
+{
+  GobChartsLabel label = m_private->m_selectedLabel;
+
+  if( m_private->m_labels.contains( label ) )
+  {
+    emit emitLabelDetails( label, m_private->labelText( label ), m_private->labelFont( label ), m_private->labelColour( label ), m_private->labelAlignment( label ) );
+
+    /* The user paused typing, the next forwarded key press resumes editing. */
+    m_private->labelGraphicsItem( label )->endForwardedEditing();
   }
 }
 
 /*--------------------------------------------------------------------------------*/
 
+void GobChartsView::updateHover()
+{
+  m_private->updateHover();
+}
+
+/*--------------------------------------------------------------------------------*/
+
 QRegion GobChartsView::visualRegionForSelection( const QItemSelection &selection ) const
 {
   QRegion region;
 
+  if( m_private->rangeSelectionAllowed() )
+  {
+    /* BAR and LINE items are in row order, so each contiguous range maps onto a single rectangle. */
+    foreach( const QItemSelectionRange &range, selection )
+    {
+      int first = GobChartsLayout::lowerBoundRow( m_private->m_geometry, range.top() );
+      int last  = GobChartsLayout::lowerBoundRow( m_private->m_geometry, range.bottom() + 1 ) - 1;
+
+      if( first <= last )
+      {
+        region += m_private->itemRect( first ).united( m_private->itemRect( last ) ).toRect();
+      }
+    }
+
+    return region;
+  }
+
   foreach( QModelIndex indexIt, selection.indexes() )
   {
-    QRectF rect = m_private->m_graphItems->getItemRectF( indexIt );
+    QRectF rect;
+
+    if( m_private->isDirect() )
+    {
+      int i = m_private->directItemForRow( indexIt.row() );
+
+      if( i >= 0 )
+      {
+        rect = m_private->m_geometry.items.at( i ).rect;
+      }
+    }
+    else
+    {
+      rect = m_private->m_graphItems->getItemRectF( indexIt );
+    }
 
     if( !rect.isNull() )
     {
@@ -1027,3 +3400,132 @@ QRegion GobChartsView::visualRegionForSelection( const QItemSelection &selection
 }
 
 /*--------------------------------------------------------------------------------*/
+
+bool GobChartsView::eventFilter( QObject *object, QEvent *event )
+{
+  if( m_private->m_latencyPending &&
+      object == m_private->m_graphicsView->viewport() &&
+      event->type() == QEvent::Paint )
+  {
+    m_private->m_latencyPending = false;
+    emit labelEditLatency( m_private->m_keystrokeClock.nsecsElapsed() / 1000000.0 );
+  }
+
+  if( m_private->isDirect() &&
+      object == m_private->m_graphicsView->viewport() &&
+      event->type() == QEvent::Paint )
+  {
+    QPainter painter( m_private->m_graphicsView->viewport() );
+    m_private->paintDirect( &painter );
+    return true;
+  }
+
+  if( object == m_private->m_graphicsView->viewport() )
+  {
+    switch( event->type() )
+    {
+    case QEvent::Wheel:
+      {
+        QWheelEvent *wheelEvent = static_cast< QWheelEvent* >( event );
+
+        /* Horizontal wheels (tilting, touchpad swipes) don't zoom. */
+        if( wheelEvent->orientation() == Qt::Vertical &&
+            m_private->m_strategy->supportsZoom() && !isStreaming() && !m_private->isScrolling() )
+        {
+          m_private->zoomAt( wheelEvent->pos(), qPow( ZOOM_STEP, -wheelEvent->delta()/120.0 ) );
+          return true;
+        }
+      }
+      break;
+    case QEvent::MouseButtonPress:
+      {
+        QMouseEvent *mouseEvent = static_cast< QMouseEvent* >( event );
+        QGraphicsItem *item = m_private->m_graphicsView->itemAt( mouseEvent->pos() );
+
+        /* Ctrl + drag pans a zoomed chart. */
+        if( mouseEvent->button() == Qt::LeftButton && ( mouseEvent->modifiers() & Qt::ControlModifier ) && m_private->isZoomed() )
+        {
+          m_private->m_panning   = true;
+          m_private->m_panOrigin = mouseEvent->pos();
+          m_private->m_panFirst  = m_private->m_zoomFirst;
+          return true;
+        }
+
+        /* Labels and headers are dragged around, not used to start a range selection. */
+        m_private->m_rubberBandArmed = ( mouseEvent->button() == Qt::LeftButton ) &&
+                                       m_private->rangeSelectionAllowed() &&
+                                       !m_private->isLabel( item );
+        m_private->m_rubberBandOrigin = mouseEvent->pos();
+      }
+      break;
+    case QEvent::MouseMove:
+      {
+        QMouseEvent *mouseEvent = static_cast< QMouseEvent* >( event );
+
+        if( m_private->m_panning )
+        {
+          int   span  = m_private->m_zoomLast - m_private->m_zoomFirst + 1;
+          qreal moved = m_private->m_graphicsView->mapToScene( mouseEvent->pos() ).x() -
+                        m_private->m_graphicsView->mapToScene( m_private->m_panOrigin ).x();
+
+          if( m_private->m_innerSceneRectF.width() > 0.0 )
+          {
+            m_private->zoomTo( m_private->m_panFirst - qRound( moved/m_private->m_innerSceneRectF.width() * span ), span );
+          }
+
+          return true;
+        }
+
+        if( mouseEvent->buttons() == Qt::NoButton )
+        {
+          m_private->m_hoverPos = mouseEvent->pos();
+
+          if( !m_private->m_hoverTimer->isActive() )
+          {
+            m_private->m_hoverTimer->start();
+          }
+        }
+
+        if( m_private->m_rubberBandArmed && ( mouseEvent->buttons() & Qt::LeftButton ) )
+        {
+          QRect rect = QRect( m_private->m_rubberBandOrigin, mouseEvent->pos() ).normalized();
+
+          if( m_private->m_rubberBand->isVisible() ||
+              ( mouseEvent->pos() - m_private->m_rubberBandOrigin ).manhattanLength() >= QApplication::startDragDistance() )
+          {
+            m_private->m_rubberBand->setGeometry( rect );
+            m_private->m_rubberBand->show();
+            return true;
+          }
+        }
+      }
+      break;
+    case QEvent::Leave:
+      m_private->m_hoverTimer->stop();
+      m_private->clearHover();
+      break;
+    case QEvent::MouseButtonRelease:
+      m_private->m_rubberBandArmed = false;
+
+      if( m_private->m_panning )
+      {
+        m_private->m_panning = false;
+        return true;
+      }
+
+      if( m_private->m_rubberBand->isVisible() )
+      {
+        m_private->m_rubberBand->hide();
+        m_private->selectRange( m_private->m_graphicsView->mapToScene( m_private->m_rubberBand->geometry() ).boundingRect() );
+        return true;
+      }
+      break;
+    default:
+      break;
+    }
+  }
+
+  return QAbstractItemView::eventFilter( object, event );
+}
+
+/*--------------------------------------------------------------------------------*/
@@ -30,48 +30,191 @@
 
 class QGraphicsView;
 class QGraphicsItem;
+class QGraphicsScene;
 class QDomNode;
 class GobChartsTextItem;
+class GobChartsIngestionQueue;
+class GobChartsViewStrategy;
+struct GobChartsGeometry;
 
-/// Abstract base class from which all chart type (view) classes must inherit.
+/// The chart view.
 
 /**  \defgroup ChartViews Chart Views
     
-    Each view class represents a specific chart type (with the exception of GobChartsView, the
-    abstract base class from which all these views derive).
+    GobChartsView displays all chart types.  Everything that is specific to a chart type is delegated to
+    a strategy (see GobChartsViewStrategy) which is created by GobChartsFactory and swapped by setChartType().
     
-    The three supported chart types and their corresponding view classes are:\n
+    The three supported chart types and their corresponding strategy classes are:\n
     - BAR - GobChartsBarView
     - PIE - GobChartsPieView
     - LINE - GobChartsLineView
 */
 
-/** Derived classes must implement the following pure virtual functions:
-
-  -# generateGraphicsItems() - creates the graphics items required for the 
-                               specific chart type and positions them within the view.
-
-  -# needsGrid() - if the chart type supports grids, this function must return "true" 
-                   (e.g. PIE charts don't support chart grids whereas BAR charts do).
-
-  -# typeInteger() - returns an integer value as a QString.  
-                     The value thus returned must match one of the GobChartsType enum values.
-*/
+/** Switching chart types only replaces the strategy: the data (and everything calculated from it), the
+    labels, the scene and all signal/slot connections remain in place and the switch costs a single relayout. */
 class GobChartsView : public QAbstractItemView,
                       public GobChartsNoCopy
 {
   Q_OBJECT
 
 public:
-  /*! Constructor.
-      Public virtual constructor so that we may delete "new"-ed derived objects from pointer-to-base.
-      GobChartsFactory and the underlying strategy pattern depend on this for run-time type polymorphism. */
+  //! Constructor (the initial chart type is BAR).
+  explicit GobChartsView( QWidget *parent = 0 );
+
+  //! Destructor.
   virtual ~GobChartsView();
 
+  /*! Sets the chart type.  Swaps the chart type strategy and redraws the chart, all other state is retained.
+      \sa chartType() */
+  void setChartType( GobChartsType type );
+
+  /*! Returns the current chart type.
+      \sa setChartType() */
+  GobChartsType chartType() const;
+
+  /*! Speculative layouts.
+      When "on", every redraw also calculates the layouts of the chart types that are not currently displayed (on a
+      worker thread, from the same data snapshot) so that setChartType() can display them immediately.  Layouts are
+      only kept for as long as they fit within "memoryBudget" bytes (default "off").
+      \sa speculativeLayoutMemory() */
+  void setSpeculativeLayouts( bool speculative, qint64 memoryBudget = DEFAULT_SPECULATIVE_BUDGET );
+
+  /*! Returns the number of bytes currently taken up by speculative layouts.
+      \sa setSpeculativeLayouts() */
+  qint64 speculativeLayoutMemory() const;
+
+  /*! Hibernation of idle charts.
+      Once the chart has been hidden (or its window minimised) for "milliseconds", its graphics items, layouts,
+      data snapshot and grid paths are released and only the (compact) valid item data is kept.  The chart is
+      rebuilt when it is shown again.  A value of 0 turns hibernation "off" (default).
+      \sa setHibernationMemoryBudget(), hibernate() and hibernationStats() */
+  void setHibernationTimeout( int milliseconds );
+
+  /*! Sets the (estimated) scene memory all charts in the application may take up together.  Whenever the
+      total exceeds "bytes", hidden charts are hibernated, least recently shown first.  Charts on screen are
+      never hibernated.  A value of 0 removes the budget (default).
+      \sa setHibernationTimeout() */
+  static void setHibernationMemoryBudget( qint64 bytes );
+
+  /*! Returns the hibernation statistics (number of hibernations and memory reclaimed).
+      \sa setHibernationTimeout() */
+  GobChartsHibernationStats hibernationStats() const;
+
+  /*! Starts a batch of settings changes.  Redraws requested by setters (and slots) called before the matching
+      endUpdate() are accumulated instead of executed.  Calls may be nested.
+      \sa endUpdate(), GobChartsUpdateGuard */
+  void beginUpdate();
+
+  /*! Ends a batch of settings changes.  Ending the outermost batch redraws the chart exactly once if any of
+      the changes made since beginUpdate() requested a redraw.
+      \sa beginUpdate() */
+  void endUpdate();
+
   /*! Displays the chosen chart type.
-      Generates and displays the chart within the confines of the QGraphicsView which contains it. */
+      Generates and displays the chart within the confines of the QGraphicsView which contains it.  If
+      asynchronous layout is enabled, the chart geometry is calculated on a worker thread and the
+      graphics items are only updated once the calculation completes.
+      \sa setAsynchronousLayout() */
   void drawChart();
 
+  /*! Asynchronous layout.
+      When "on", the chart geometry (bar rectangles, line points, pie angles) is calculated on a worker thread
+      from an immutable snapshot of the data and only the finished geometry is applied to the scene on the GUI
+      thread.  A layout that is still in progress when a newer redraw is requested is abandoned (default "off"). */
+  void setAsynchronousLayout( bool async );
+
+  /*! Real-time data ingestion.
+      Sets the queue from which samples pushed by a data acquisition thread are drained.  While a queue is set,
+      it is drained at the ingestion rate and all pending samples are applied to the model in a single batch,
+      followed by a single recalculation of the totals and a single redraw.  The view does NOT take ownership
+      of the queue and passing NULL stops ingestion.
+      \sa setIngestionRate() */
+  void setIngestionQueue( GobChartsIngestionQueue *queue );
+
+  /*! Sets the number of times per second the ingestion queue is drained (default 30).
+      \sa setIngestionQueue() */
+  void setIngestionRate( int framesPerSecond );
+
+  /*! Render scheduler.
+      Caps the number of redraws per second to "framesPerSecond".  All redraw requests (model changes,
+      setting changes, resizes, etc) arriving between two frames are merged into a single redraw.  A value
+      of 0 (the default) disables the scheduler, i.e. every request results in an immediate redraw.
+      \sa setFrameBudget() and renderStats() */
+  void setMaximumFrameRate( int framesPerSecond );
+
+  /*! Sets the time (in milliseconds) a single redraw is allowed to take (default 0, i.e. one frame interval).
+      Once a redraw has used up its budget, the graphics items it has not created yet are handed to the progressive
+      builder (see setProgressiveRendering()), which creates them in time slices while the event loop keeps running.
+      The layout calculation itself is not interrupted; if it alone exceeds the budget, the frame slots the redraw
+      overran into are skipped (and reported as dropped) rather than being caught up on.
+      \sa setMaximumFrameRate() and renderStats() */
+  void setFrameBudget( int milliseconds );
+
+  /*! Returns the render scheduler's statistics.
+      \sa resetRenderStats() */
+  GobChartsRenderStats renderStats() const;
+
+  /*! Resets the render scheduler's statistics.
+      \sa renderStats() */
+  void resetRenderStats();
+
+  /*! Layered rendering.
+      When "on", the static layers (background, grid, axes and labels) are cached and only re-rendered when
+      the chart geometry or the grid settings change, i.e. data-only updates merely repaint the chart items.
+      When "off" (the default), the grid is rebuilt and the labels are re-fitted on every redraw. */
+  void setLayeredRendering( bool layered );
+
+  /*! Scrolling mode (BAR charts only).  When "on", bars are never narrower than "minimumBarWidth" and a horizontal
+      scroll bar appears as soon as they no longer all fit.  Only the bars inside the visible window are laid out
+      and created, which keeps the number of graphics items (and the memory held) proportional to the width of the
+      view rather than to the number of rows, while the legend lists all bars (default "off").
+      \sa scrollTo() */
+  void setScrollingMode( bool scrolling, qreal minimumBarWidth = DEFAULT_MIN_BAR_WIDTH );
+
+  /*! Zooms BAR and LINE charts into the positions (indices of the valid items, see nrValidItems()) "firstPosition"
+      to "lastPosition", which are then spread across the full width of the chart.  Displayed ranges (zoomed or not)
+      holding more positions than can be told apart are rendered from a min/max/sum data pyramid (one item per bucket
+      of 2^k positions), so the number of items stays proportional to the chart's width.  Zooming is also available via the mouse wheel and
+      zoomed charts may be panned with Ctrl + drag.  Not available in scrolling or streaming mode.
+      \sa resetZoom() */
+  void setZoomRange( int firstPosition, int lastPosition );
+
+  /*! Shows all positions again.
+      \sa setZoomRange() */
+  void resetZoom();
+
+  /*! Rendering backend.
+      SCENE_BACKEND (the default) creates a QGraphicsItem per chart item.  DIRECT_BACKEND bypasses the scene for the
+      chart items altogether: background, grid, chart items and labels are painted straight onto the viewport from the
+      calculated geometry and hit testing is done against the geometry as well.  This is considerably cheaper for
+      dense charts.  Streaming charts always use the scene. */
+  void setRenderBackend( GobChartsBackend backend );
+
+  /*! Progressive rendering.
+      When "on", charts with a very large number of items are built in slices of at most "timeSlice" milliseconds
+      spread over consecutive event loop iterations so that the GUI remains responsive.  A coarse, aggregated preview
+      is displayed until all items have been added.  A redraw requested while a build is in progress cancels it. */
+  void setProgressiveRendering( bool progressive, int timeSlice = DEFAULT_TIME_SLICE );
+
+  /*! Level of detail.
+      Sets the quality tier used while the user (or live data) is interacting with the chart, i.e. during resizes,
+      selections and data updates.  Full quality is restored once there has been no interaction for "restoreDelay"
+      milliseconds.  FULL_QUALITY (the default) disables the tier switching altogether.
+      \sa renderQuality() */
+  void setInteractiveQuality( GobChartsQuality quality, int restoreDelay = DEFAULT_RESTORE_DELAY );
+
+  /*! Streaming mode.
+      Displays the last "windowSize" samples passed to appendStreamSample() instead of the model's data
+      (0 turns streaming off again).  "mode" determines whether the samples are kept as individual graphics
+      items or rasterised into a scrolling strip.  Only chart types that support streaming (LINE) honour this
+      request, it is merely logged otherwise.  Changing the chart type turns streaming off.
+      \sa appendStreamSample() */
+  void setStreamingWindow( int windowSize, GobChartsStreamMode mode = STREAM_ITEMS );
+
+  /*! Appends a sample to the streaming window (only relevant in streaming mode).
+      \sa setStreamingWindow() */
+  void appendStreamSample( qreal value );
+
   /*! Informs the view that a legend of name "text" has been selected. */
   void legendItemSelected( const QString &text );
 
@@ -92,6 +235,12 @@ public:
       \sa setStateXML() */
   QString getStateXML( bool includeData = true ) const;
 
+  /*! Returns the number of valid items that fall within the allowed data range (i.e. the number of
+      items that will actually be drawn).  This is resolved via a binary search over the value-sorted
+      index and does not require the chart to be redrawn.
+      \sa setAllowedDataRange() and visibleItemCount() */
+  int nrVisibleItems() const;
+
   /*! Re-implemented from QAbstractItemView. See the Qt API documentation for details. */
   QRect visualRect( const QModelIndex &index ) const;
 
@@ -164,6 +313,12 @@ public slots:
       \sa lastDebugLogMsg() */
   void setDebugLoggingOn( bool logging );
 
+  /*! Hibernate.
+      Releases the chart's scene memory straight away (see setHibernationTimeout()).  Does nothing if the chart
+      is on screen, streaming or already hibernating.
+      \sa hibernationStats() */
+  void hibernate();
+
 signals:
   /*! Debug messages.
       This signal broadcasts the last debug log message and will only be emitted when debug logging is turned "on".
@@ -175,6 +330,11 @@ signals:
       \sa requestLabelDetails() and setLabelDetails() */
   void emitLabelDetails( GobChartsLabel label, const QString &text, const QFont &font, const QColor &colour, Qt::Alignment align );
 
+  /*! Label editing latency.
+      Emitted once per label keystroke (or burst of keystrokes handled before the next repaint) with the time (in
+      milliseconds) from the key press to the delivery of the paint event that displays it. */
+  void labelEditLatency( qreal milliseconds );
+
   /*! Emitted when a new graphics item was created.
       This signal is emitted shortly after a graphics item is created and contains the details for the
       corresponding legend item. */
@@ -186,30 +346,30 @@ signals:
   /*! Emitted when a graphics item is selected. */
   void highLightLegendItem( const QString &text );
 
+  /*! Emitted whenever the allowed data range changes, before the chart is redrawn.  The
+      parameter is the number of items that fall within the new range.
+      \sa nrVisibleItems() and setAllowedDataRange() */
+  void visibleItemCount( int count );
+
 protected:
   /*! Expected data model columns. 
       GobChartsWidget is only capable of displaying one to one mappings between categories and data values and expects
       the first column of the data model to contain the chart's category names and the second the corresponding data values. */
   enum GobChartsColumn { CATEGORY, VALUE };
 
-  //! Destructor.
-  explicit GobChartsView( QWidget *parent = 0 );
-
-  /*! Derived classes must implement this function.
-      This function must create the graphics items required for the specific chart type 
-      and position them within the confines of the view. */
-  virtual void generateGraphicsItems() = 0;
+  /*! Returns "true" if the view is currently displaying streamed samples rather than the model's data.
+      While streaming, drawChart() updates the chart geometry, grid and labels as usual but lets the
+      strategy reposition the streamed items instead of laying out the model's data.
+      \sa setStreamingWindow() */
+  bool isStreaming() const;
 
-  /*! Derived classes must implement this function.
-      This function must return "true" when the chart type supports grid lines and "false"
-      otherwise (e.g. PIE charts don't support chart grids whereas BAR charts do). */
-  virtual bool needsGrid() const = 0;
+  /*! Returns the scene the chart is drawn on. */
+  QGraphicsScene *chartScene() const;
 
-  /*! Derived classes must implement this function.
-      This function must return an integer value that matches one of the GobChartsType enum
-      values as a QString (this information is used when saving and loading charts to and
-      from file). */
-  virtual QString typeInteger()  const = 0;
+  /*! Returns the quality tier graphics items must currently be created (or painted) at.  Antialiasing and the
+      enabling/disabling of existing items' effects are taken care of by GobChartsView.
+      \sa setInteractiveQuality() */
+  GobChartsQuality renderQuality() const;
 
   /*! Returns "true" if the chart colour is fixed or "false" if random colours must be generated.
       \sa setFixedColour(), setRandomColours and fixedColour() */
@@ -251,6 +411,12 @@ protected:
       \sa setAllowedDataRange() and setShowTotalRange() */
   bool  isWithinAllowedRange( qreal value ) const;
 
+  /*! Returns the positions (indices into validRowList()) of all items that fall within the allowed
+      data range, in ascending order.  Views should iterate over these rather than testing every
+      valid item with isWithinAllowedRange().
+      \sa nrVisibleItems() */
+  QList< int > visiblePositions() const;
+
   /*! Returns the grid width.  Within the context of the allowed space, this is the width that the grid may occupy. */
   qreal gridWidth() const;
 
@@ -283,6 +449,9 @@ protected:
   /*! Re-implemented from QAbstractItemView. See the Qt API documentation for details. */
   void keyPressEvent( QKeyEvent *event );
 
+  /*! Re-implemented from QAbstractItemView. See the Qt API documentation for details. */
+  bool eventFilter( QObject *object, QEvent *event );
+
 protected slots:
   /*! Log debug messages. This slot receives logging information from privately owned objects. */ 
   void debugLog( QString msg );
@@ -307,14 +476,82 @@ private:
      anyway, with one or two utility methods thrown in). */
   friend class GobChartsViewPrivate;
   class GobChartsViewPrivate;
+  friend class GobChartsViewStrategy;     // provides the strategies with access to the protected functions
   GobChartsViewPrivate* const m_private;
 
   /*! Re-implemented from QAbstractItemView. See the Qt API documentation for details. */
   void resizeEvent( QResizeEvent *event );
 
+  /*! Re-implemented from QAbstractItemView. See the Qt API documentation for details. */
+  void showEvent( QShowEvent *event );
+
+  /*! Re-implemented from QAbstractItemView. See the Qt API documentation for details. */
+  void hideEvent( QHideEvent *event );
+
+  /*! Re-implemented from QAbstractScrollArea. See the Qt API documentation for details. */
+  void scrollContentsBy( int dx, int dy );
+
+  /*! Replaces the current graphics items with items created from "geometry". */
+  void applyGeometry( const GobChartsGeometry &geometry );
+
 private slots:
   /*! Sets the header or label item that's supposed to receive keyboard input. */
   void setSelectedTextItem( const QString &itemName );
+
+  /*! Receives the result of an asynchronous layout calculation. */
+  void layoutFinished();
+
+  /*! Receives the layouts calculated for the chart types not currently displayed. */
+  void speculativeLayoutsFinished();
+
+  /*! Renders the frame scheduled by the render scheduler. */
+  void renderScheduledFrame();
+
+  /*! Applies all samples currently waiting in the ingestion queue. */
+  void drainIngestionQueue();
+
+  /*! Creates and adds the next slice of graphics items during a progressive build. */
+  void buildNextSlice();
+
+  /*! Returns to FULL_QUALITY once interaction has stopped. */
+  void restoreFullQuality();
+
+  /*! Broadcasts the edited label's details once label editing pauses. */
+  void syncLabelDetails();
+
+  /*! Updates the hover outline and tooltip for the last known mouse position. */
+  void updateHover();
+};
+
+/*--------------------------------------------------------------------------------*/
+
+/// Scoped beginUpdate()/endUpdate() pair.
+
+/** Calls GobChartsView::beginUpdate() on construction and GobChartsView::endUpdate() on destruction
+    so that a batch of settings changes results in a single redraw, even if the scope is left early. */
+class GobChartsUpdateGuard : public GobChartsNoCopy
+{
+public:
+  //! Constructor. "view" may be NULL, in which case the guard does nothing.
+  explicit GobChartsUpdateGuard( GobChartsView *view ) : m_view( view )
+  {
+    if( m_view )
+    {
+      m_view->beginUpdate();
+    }
+  }
+
+  //! Destructor.
+  ~GobChartsUpdateGuard()
+  {
+    if( m_view )
+    {
+      m_view->endUpdate();
+    }
+  }
+
+private:
+  GobChartsView *m_view;
 };
 
 #endif // GOBCHARTSVIEW_H
@@ -0,0 +1,141 @@
+/* Copyright (C) 2012 by William Hallatt.
+ *
+ * This file forms part of the "GobChartsWidget" library.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have downloaded a copy of the GNU General Public License
+ * (GNUGPL.txt) and GNU Lesser General Public License (GNULGPL.txt)
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * The official website for this project is www.goblincoding.com and,
+ * although not compulsory, it would be appreciated if all works of whatever
+ * nature referring to or using this library include a reference to this site.
+ */
+
+#include "gobchartsviewstrategy.h"
+#include "gobchartsview.h"
+
+/*--------------------------------------------------------------------------------*/
+
+GobChartsViewStrategy::GobChartsViewStrategy( GobChartsView *view ) :
+  m_view( view )
+{
+}
+
+/*--------------------------------------------------------------------------------*/
+
+GobChartsViewStrategy::~GobChartsViewStrategy()
+{
+  // Default destructor
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsViewStrategy::setStreamingWindow( int windowSize, GobChartsStreamMode mode )
+{
+  Q_UNUSED( windowSize );
+  Q_UNUSED( mode );
+  debugLog( tr( "GobChartsViewStrategy::setStreamingWindow# Chart type [%1] does not support streaming." ).arg( typeInteger() ) );
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsViewStrategy::appendStreamSample( qreal value )
+{
+  Q_UNUSED( value );
+}
+
+/*--------------------------------------------------------------------------------*/
+
+bool GobChartsViewStrategy::isStreaming() const
+{
+  return false;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsViewStrategy::relayoutStream()
+{
+  // Default implementation does nothing
+}
+
+/*--------------------------------------------------------------------------------*/
+
+bool GobChartsViewStrategy::supportsZoom() const
+{
+  return false;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+GobChartsView *GobChartsViewStrategy::view() const
+{
+  return m_view;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+QGraphicsScene *GobChartsViewStrategy::chartScene() const
+{
+  return m_view->chartScene();
+}
+
+/*--------------------------------------------------------------------------------*/
+
+GobChartsQuality GobChartsViewStrategy::renderQuality() const
+{
+  return m_view->renderQuality();
+}
+
+/*--------------------------------------------------------------------------------*/
+
+bool GobChartsViewStrategy::useFixedColour() const
+{
+  return m_view->useFixedColour();
+}
+
+/*--------------------------------------------------------------------------------*/
+
+QColor GobChartsViewStrategy::fixedColour() const
+{
+  return m_view->fixedColour();
+}
+
+/*--------------------------------------------------------------------------------*/
+
+int GobChartsViewStrategy::nrValidItems() const
+{
+  return m_view->nrValidItems();
+}
+
+/*--------------------------------------------------------------------------------*/
+
+const QRectF &GobChartsViewStrategy::innerSceneRectF() const
+{
+  return m_view->innerSceneRectF();
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsViewStrategy::drawChart() const
+{
+  m_view->drawChart();
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsViewStrategy::debugLog( const QString &msg ) const
+{
+  m_view->debugLog( msg );
+}
+
+/*--------------------------------------------------------------------------------*/
@@ -0,0 +1,135 @@
+/* Copyright (C) 2012 by William Hallatt.
+ *
+ * This file forms part of the "GobChartsWidget" library.
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have downloaded a copy of the GNU General Public License
+ * (GNUGPL.txt) and GNU Lesser General Public License (GNULGPL.txt)
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * The official website for this project is www.goblincoding.com and,
+ * although not compulsory, it would be appreciated if all works of whatever
+ * nature referring to or using this library include a reference to this site.
+ */
+
+#ifndef GOBCHARTSVIEWSTRATEGY_H
+#define GOBCHARTSVIEWSTRATEGY_H
+
+#include <QCoreApplication>
+#include <QColor>
+#include <QRectF>
+#include "utils/globalincludes.h"
+#include "utils/gobchartsnocopy.h"
+
+class GobChartsView;
+class QGraphicsItem;
+class QGraphicsScene;
+class QPainter;
+struct GobChartsGeometryItem;
+
+/**  \ingroup ChartViews */
+
+/// Abstract base class from which all chart type strategies must inherit.
+
+/** GobChartsView delegates everything that is specific to a chart type to its current strategy.
+    Swapping the strategy (see GobChartsView::setChartType()) changes the chart type without
+    touching the data, the labels or the scene.
+
+    Derived classes must implement the following pure virtual functions:
+
+  -# createGraphicsItem() - creates the graphics item required for the specific chart type
+                            from the geometry calculated for it by GobChartsLayout.
+
+  -# paintItem() - paints a single chart item from its geometry (used by the DIRECT_BACKEND).
+
+  -# chartType() - returns the GobChartsType the strategy represents (this determines
+                   which layout function is used to calculate the item geometry).
+
+  -# needsGrid() - if the chart type supports grids, this function must return "true" 
+                   (e.g. PIE charts don't support chart grids whereas BAR charts do).
+
+  -# typeInteger() - returns an integer value as a QString.  
+                     The value thus returned must match one of the GobChartsType enum values.
+*/
+class GobChartsViewStrategy : public GobChartsNoCopy
+{
+  Q_DECLARE_TR_FUNCTIONS( GobChartsViewStrategy )
+
+public:
+  //! Constructor.
+  explicit GobChartsViewStrategy( GobChartsView *view );
+
+  //! Destructor.
+  virtual ~GobChartsViewStrategy();
+
+  /*! Derived classes must implement this function.
+      This function must create the graphics item for a single chart item from the geometry calculated
+      for it (the view takes care of the legend, the model index mapping and the scene). */
+  virtual QGraphicsItem *createGraphicsItem( const GobChartsGeometryItem &geometryItem ) = 0;
+
+  /*! Derived classes must implement this function.
+      This function must paint a single chart item from its geometry with "painter" (scene coordinates) and
+      should look the same as the item created by createGraphicsItem(). */
+  virtual void paintItem( QPainter *painter, const GobChartsGeometryItem &geometryItem ) const = 0;
+
+  /*! Derived classes must implement this function.
+      This function must return the chart type the strategy represents. */
+  virtual GobChartsType chartType() const = 0;
+
+  /*! Derived classes must implement this function.
+      This function must return "true" when the chart type supports grid lines and "false"
+      otherwise (e.g. PIE charts don't support chart grids whereas BAR charts do). */
+  virtual bool needsGrid() const = 0;
+
+  /*! Derived classes must implement this function.
+      This function must return an integer value that matches one of the GobChartsType enum
+      values as a QString (this information is used when saving and loading charts to and
+      from file). */
+  virtual QString typeInteger() const = 0;
+
+  /*! Streaming mode (see GobChartsView::setStreamingWindow()).  Only chart types that support streaming
+      re-implement this function, the default implementation merely logs that streaming is not supported. */
+  virtual void setStreamingWindow( int windowSize, GobChartsStreamMode mode );
+
+  /*! Appends a sample to the streaming window (default implementation does nothing). */
+  virtual void appendStreamSample( qreal value );
+
+  /*! Returns "true" if the chart is currently displaying streamed samples rather than the model's data (default "false"). */
+  virtual bool isStreaming() const;
+
+  /*! Called by GobChartsView::drawChart() in streaming mode once the inner scene rectangle is up to date.  Strategies
+      that support streaming must reposition their streamed items here (default implementation does nothing). */
+  virtual void relayoutStream();
+
+  /*! Returns "true" if the chart type can be zoomed into a range of positions (see GobChartsView::setZoomRange()).
+      Only chart types with an x ordering qualify (default "false"). */
+  virtual bool supportsZoom() const;
+
+protected:
+  /*! Returns the view the strategy draws for. */
+  GobChartsView *view() const;
+
+  /*! Convenience access to the view's (protected) functionality, see GobChartsView for details. */
+  QGraphicsScene  *chartScene() const;
+  GobChartsQuality renderQuality() const;
+  bool             useFixedColour() const;
+  QColor           fixedColour() const;
+  int              nrValidItems() const;
+  const QRectF    &innerSceneRectF() const;
+  void             drawChart() const;
+  void             debugLog( const QString &msg ) const;
+
+private:
+  GobChartsView *m_view;
+};
+
+#endif // GOBCHARTSVIEWSTRATEGY_H
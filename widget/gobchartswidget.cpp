@@ -22,7 +22,6 @@
  */
 
 #include "gobchartswidget.h"
-#include "view/gobchartsfactory.h"
 #include "view/gobchartsview.h"
 #include "toolswidget/gobchartstoolswidget.h"
 
@@ -71,7 +70,25 @@ struct GobChartsWidget::GobChartsWidgetPrivate
     m_frame             ( new QFrame ),
     m_model             ( NULLPOINTER ),
     m_selectionModel    ( NULLPOINTER ),
-    m_loggingOn         ( false )
+    m_ingestionQueue    ( NULLPOINTER ),
+    m_ingestionRate     ( DEFAULT_INGESTION_RATE ),
+    m_maxFrameRate      ( 0 ),
+    m_frameBudget       ( 0 ),
+    m_streamingWindow   ( 0 ),
+    m_streamMode        ( STREAM_ITEMS ),
+    m_layeredRendering  ( false ),
+    m_backend           ( SCENE_BACKEND ),
+    m_progressive       ( false ),
+    m_timeSlice         ( DEFAULT_TIME_SLICE ),
+    m_interactiveQuality( FULL_QUALITY ),
+    m_restoreDelay      ( DEFAULT_RESTORE_DELAY ),
+    m_speculative       ( false ),
+    m_speculativeBudget ( DEFAULT_SPECULATIVE_BUDGET ),
+    m_scrolling         ( false ),
+    m_minimumBarWidth   ( DEFAULT_MIN_BAR_WIDTH ),
+    m_hibernationTimeout( 0 ),
+    m_loggingOn         ( false ),
+    m_asyncLayout       ( false )
   {
     m_legend->setAlternatingRowColors( true );
     m_horizontalSplitter->addWidget( m_legend );   // chart view added later
@@ -103,6 +120,7 @@ struct GobChartsWidget::GobChartsWidgetPrivate
       m_frame
       m_model
       m_selectionModel
+      m_ingestionQueue
     */
   }
 
@@ -115,7 +133,25 @@ struct GobChartsWidget::GobChartsWidgetPrivate
   QFrame               *m_frame;
   QAbstractItemModel   *m_model;           // model owned elsewhere
   QItemSelectionModel  *m_selectionModel;  // selection model owned elsewhere
+  GobChartsIngestionQueue *m_ingestionQueue;  // queue owned elsewhere
+  int                   m_ingestionRate;
+  int                   m_maxFrameRate;
+  int                   m_frameBudget;
+  int                   m_streamingWindow;
+  GobChartsStreamMode   m_streamMode;
+  bool                  m_layeredRendering;
+  GobChartsBackend      m_backend;
+  bool                  m_progressive;
+  int                   m_timeSlice;
+  GobChartsQuality      m_interactiveQuality;
+  int                   m_restoreDelay;
+  bool                  m_speculative;
+  qint64                m_speculativeBudget;
+  bool                  m_scrolling;
+  qreal                 m_minimumBarWidth;
+  int                   m_hibernationTimeout;
   bool                  m_loggingOn;
+  bool                  m_asyncLayout;
 };
 
 
@@ -171,6 +207,231 @@ void GobChartsWidget::setDebugLoggingOn( bool log )
 
 /*--------------------------------------------------------------------------------*/
 
+void GobChartsWidget::setAsynchronousLayout( bool async )
+{
+  if( m_private->m_gobChartsView )
+  {
+    m_private->m_gobChartsView->setAsynchronousLayout( async );
+  }
+
+  /* Remember setting for later when charts are created and/or recreated. */
+  m_private->m_asyncLayout = async;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsWidget::setIngestionQueue( GobChartsIngestionQueue *queue, int framesPerSecond )
+{
+  if( m_private->m_gobChartsView )
+  {
+    m_private->m_gobChartsView->setIngestionRate( framesPerSecond );
+    m_private->m_gobChartsView->setIngestionQueue( queue );
+  }
+
+  /* Remember setting for later when charts are created and/or recreated. */
+  m_private->m_ingestionQueue = queue;
+  m_private->m_ingestionRate  = framesPerSecond;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsWidget::setMaximumFrameRate( int framesPerSecond, int frameBudget )
+{
+  if( m_private->m_gobChartsView )
+  {
+    m_private->m_gobChartsView->setMaximumFrameRate( framesPerSecond );
+    m_private->m_gobChartsView->setFrameBudget( frameBudget );
+  }
+
+  /* Remember setting for later when charts are created and/or recreated. */
+  m_private->m_maxFrameRate = framesPerSecond;
+  m_private->m_frameBudget  = frameBudget;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+GobChartsRenderStats GobChartsWidget::renderStats() const
+{
+  if( m_private->m_gobChartsView )
+  {
+    return m_private->m_gobChartsView->renderStats();
+  }
+
+  return GobChartsRenderStats();
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsWidget::setLayeredRendering( bool layered )
+{
+  if( m_private->m_gobChartsView )
+  {
+    m_private->m_gobChartsView->setLayeredRendering( layered );
+  }
+
+  /* Remember setting for later when charts are created and/or recreated. */
+  m_private->m_layeredRendering = layered;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsWidget::setRenderBackend( GobChartsBackend backend )
+{
+  if( m_private->m_gobChartsView )
+  {
+    m_private->m_gobChartsView->setRenderBackend( backend );
+  }
+
+  /* Remember setting for later when charts are created and/or recreated. */
+  m_private->m_backend = backend;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsWidget::setProgressiveRendering( bool progressive, int timeSlice )
+{
+  if( m_private->m_gobChartsView )
+  {
+    m_private->m_gobChartsView->setProgressiveRendering( progressive, timeSlice );
+  }
+
+  /* Remember setting for later when charts are created and/or recreated. */
+  m_private->m_progressive = progressive;
+  m_private->m_timeSlice   = timeSlice;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsWidget::setInteractiveQuality( GobChartsQuality quality, int restoreDelay )
+{
+  if( m_private->m_gobChartsView )
+  {
+    m_private->m_gobChartsView->setInteractiveQuality( quality, restoreDelay );
+  }
+
+  /* Remember setting for later when charts are created and/or recreated. */
+  m_private->m_interactiveQuality = quality;
+  m_private->m_restoreDelay       = restoreDelay;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsWidget::setSpeculativeLayouts( bool speculative, qint64 memoryBudget )
+{
+  if( m_private->m_gobChartsView )
+  {
+    m_private->m_gobChartsView->setSpeculativeLayouts( speculative, memoryBudget );
+  }
+
+  /* Remember setting for later when charts are created and/or recreated. */
+  m_private->m_speculative       = speculative;
+  m_private->m_speculativeBudget = memoryBudget;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsWidget::setScrollingMode( bool scrolling, qreal minimumBarWidth )
+{
+  if( m_private->m_gobChartsView )
+  {
+    m_private->m_gobChartsView->setScrollingMode( scrolling, minimumBarWidth );
+  }
+
+  /* Remember setting for later when charts are created and/or recreated. */
+  m_private->m_scrolling       = scrolling;
+  m_private->m_minimumBarWidth = minimumBarWidth;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsWidget::setHibernationTimeout( int milliseconds )
+{
+  if( m_private->m_gobChartsView )
+  {
+    m_private->m_gobChartsView->setHibernationTimeout( milliseconds );
+  }
+
+  /* Remember setting for later when charts are created and/or recreated. */
+  m_private->m_hibernationTimeout = milliseconds;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsWidget::setHibernationMemoryBudget( qint64 bytes )
+{
+  GobChartsView::setHibernationMemoryBudget( bytes );
+}
+
+/*--------------------------------------------------------------------------------*/
+
+GobChartsHibernationStats GobChartsWidget::hibernationStats() const
+{
+  if( m_private->m_gobChartsView )
+  {
+    return m_private->m_gobChartsView->hibernationStats();
+  }
+
+  return GobChartsHibernationStats();
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsWidget::setZoomRange( int firstPosition, int lastPosition )
+{
+  if( m_private->m_gobChartsView )
+  {
+    m_private->m_gobChartsView->setZoomRange( firstPosition, lastPosition );
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsWidget::resetZoom()
+{
+  if( m_private->m_gobChartsView )
+  {
+    m_private->m_gobChartsView->resetZoom();
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+
+qint64 GobChartsWidget::speculativeLayoutMemory() const
+{
+  if( m_private->m_gobChartsView )
+  {
+    return m_private->m_gobChartsView->speculativeLayoutMemory();
+  }
+
+  return 0;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsWidget::setStreamingWindow( int windowSize, GobChartsStreamMode mode )
+{
+  if( m_private->m_gobChartsView )
+  {
+    m_private->m_gobChartsView->setStreamingWindow( windowSize, mode );
+  }
+
+  /* Remember setting for later when charts are created and/or recreated. */
+  m_private->m_streamingWindow = windowSize;
+  m_private->m_streamMode      = mode;
+}
+
+/*--------------------------------------------------------------------------------*/
+
+void GobChartsWidget::appendStreamSample( qreal value )
+{
+  if( m_private->m_gobChartsView )
+  {
+    m_private->m_gobChartsView->appendStreamSample( value );
+  }
+}
+
+/*--------------------------------------------------------------------------------*/
+
 void GobChartsWidget::setModel( QAbstractItemModel *model )
 {
   if( model )
@@ -234,28 +495,38 @@ void GobChartsWidget::clearLegend()
 
 void GobChartsWidget::createChart( GobChartsType type )
 {
-  /* Save the label state before whacking the chart (GobChartsView
-    is the only object that has access to all three labels' details). */
-  QString labels( "" );
-
+  /* Switching between chart types merely swaps the view's chart type strategy, the data, labels,
+    scene and connections are all retained (and the chart is redrawn once). */
   if( m_private->m_gobChartsView )
   {
-    labels = m_private->m_gobChartsView->getStateXML( false );
+    m_private->m_gobChartsView->setChartType( type );
 
-    m_private->m_gobChartsView->close();
-    delete m_private->m_gobChartsView;
-    m_private->m_gobChartsView = NULLPOINTER;
+    if( m_private->m_gobChartsView->chartType() != type )
+    {
+      QMessageBox::critical( this, tr( "Error" ), tr( "Unknown chart type selected." ) );
+    }
+    else if( m_private->m_streamingWindow > 0 )
+    {
+      /* Streaming is chart type specific. */
+      m_private->m_gobChartsView->setStreamingWindow( m_private->m_streamingWindow, m_private->m_streamMode );
+    }
+
+    return;
   }
 
-  m_private->m_gobChartsView = GobChartsFactory::getInstance()->createChart( type, this );
+  m_private->m_gobChartsView = new GobChartsView( this );
+  m_private->m_gobChartsView->setChartType( type );
 
-  if( m_private->m_gobChartsView )
+  if( m_private->m_gobChartsView->chartType() == type )
   {
     m_private->m_gobChartsView->setSizePolicy( QSizePolicy::Expanding, QSizePolicy::Expanding );
 
     connect( m_private->m_gobChartsView, SIGNAL( lastDebugLogMsg( QString ) ),
              this,                       SIGNAL( lastDebugLogMsg( QString ) ) );
 
+    connect( m_private->m_gobChartsView, SIGNAL( labelEditLatency( qreal ) ),
+             this,                       SIGNAL( labelEditLatency( qreal ) ) );
+
     /* Data range. */
     connect( m_private->m_toolsWidget,   SIGNAL( setAllowedDataRange( qreal, qreal ) ),
              m_private->m_gobChartsView, SLOT  ( setAllowedDataRange( qreal, qreal ) ) );
@@ -303,23 +574,25 @@ void GobChartsWidget::createChart( GobChartsType type )
     connect( m_private->m_gobChartsView, SIGNAL( clearLegend() ),
              this,                       SLOT  ( clearLegend() ) );
 
+    /* Everything from here on only results in a single redraw. */
+    GobChartsUpdateGuard guard( m_private->m_gobChartsView );
+
     /* The previous state (if any) saved in the tools widget will be re-applied by emitting all
     the information via the signals above (with the exception of the label information). */
     m_private->m_toolsWidget->emitStateSignals();
 
-    /* Update the labels with the saved data from above. */
-    if( !labels.isEmpty() )
-    {
-      QDomDocument doc;
-
-      /* If this fails, it isn't the end of the world. */
-      if( doc.setContent( labels ) )
-      {
-        m_private->m_gobChartsView->setStateXML( doc.namedItem( "View" ), QDomNode(), false );
-      }
-    }
-
     m_private->m_gobChartsView->setDebugLoggingOn( m_private->m_loggingOn );
+    m_private->m_gobChartsView->setAsynchronousLayout( m_private->m_asyncLayout );
+    m_private->m_gobChartsView->setIngestionRate( m_private->m_ingestionRate );
+    m_private->m_gobChartsView->setMaximumFrameRate( m_private->m_maxFrameRate );
+    m_private->m_gobChartsView->setFrameBudget( m_private->m_frameBudget );
+    m_private->m_gobChartsView->setLayeredRendering( m_private->m_layeredRendering );
+    m_private->m_gobChartsView->setRenderBackend( m_private->m_backend );
+    m_private->m_gobChartsView->setProgressiveRendering( m_private->m_progressive, m_private->m_timeSlice );
+    m_private->m_gobChartsView->setInteractiveQuality( m_private->m_interactiveQuality, m_private->m_restoreDelay );
+    m_private->m_gobChartsView->setSpeculativeLayouts( m_private->m_speculative, m_private->m_speculativeBudget );
+    m_private->m_gobChartsView->setScrollingMode( m_private->m_scrolling, m_private->m_minimumBarWidth );
+    m_private->m_gobChartsView->setHibernationTimeout( m_private->m_hibernationTimeout );
 
     if( m_private->m_model )
     {
@@ -331,6 +604,16 @@ void GobChartsWidget::createChart( GobChartsType type )
       m_private->m_gobChartsView->setSelectionModel( m_private->m_selectionModel );
     }
 
+    if( m_private->m_ingestionQueue )
+    {
+      m_private->m_gobChartsView->setIngestionQueue( m_private->m_ingestionQueue );
+    }
+
+    if( m_private->m_streamingWindow > 0 )
+    {
+      m_private->m_gobChartsView->setStreamingWindow( m_private->m_streamingWindow, m_private->m_streamMode );
+    }
+
     /* Chart should get maximum space. */
     m_private->m_horizontalSplitter->insertWidget( 0, m_private->m_gobChartsView );
     m_private->m_horizontalSplitter->setStretchFactor( 0, 1 );
@@ -351,6 +634,9 @@ void GobChartsWidget::createChart( GobChartsType type )
   else
   {
     QMessageBox::critical( this, tr( "Error" ), tr( "Unknown chart type selected." ) );
+
+    delete m_private->m_gobChartsView;
+    m_private->m_gobChartsView = NULLPOINTER;
   }
 }
 
@@ -451,6 +737,8 @@ void GobChartsWidget::loadChart()
           GobChartsType type = static_cast< GobChartsType >( strVal.toInt() );
           createChart( type );
 
+          GobChartsUpdateGuard guard( m_private->m_gobChartsView );
+
           if( m_private->m_gobChartsView )
           {
             m_private->m_gobChartsView->setStateXML( doc.namedItem( "GobChart" ).namedItem( "View" ),
@@ -32,6 +32,7 @@
 class QAbstractItemModel;
 class QItemSelectionModel;
 class QListWidgetItem;
+class GobChartsIngestionQueue;
 
 /*! \mainpage The GobChartsWidget Library
 
@@ -143,11 +144,94 @@ public:
       \sa lastDebugLogMsg() */
   void setDebugLoggingOn( bool log );
 
+  /*! Turn asynchronous layout "on" or "off" (default "off").  When "on", chart geometry is calculated
+      on a worker thread so that large charts do not block the user interface while being laid out. */
+  void setAsynchronousLayout( bool async );
+
+  /*! Set the queue through which a data acquisition thread feeds samples to the chart (GobChartsWidget does
+      NOT take ownership).  The queue is drained "framesPerSecond" times per second and all pending samples
+      are applied to the model in one batch.  Passing NULL stops ingestion.
+      \sa GobChartsIngestionQueue */
+  void setIngestionQueue( GobChartsIngestionQueue *queue, int framesPerSecond = DEFAULT_INGESTION_RATE );
+
+  /*! Cap the number of chart redraws per second (default 0, i.e. no cap).  Redraw requests arriving between
+      frames are merged and a redraw taking longer than "frameBudget" milliseconds (0 means one frame interval)
+      leaves the graphics items it has not created yet to later time slices and drops the frames it overran into.
+      \sa renderStats() */
+  void setMaximumFrameRate( int framesPerSecond, int frameBudget = 0 );
+
+  /*! Returns the current chart's render statistics (frame rate, render times and dropped frames).
+      \sa setMaximumFrameRate() */
+  GobChartsRenderStats renderStats() const;
+
+  /*! Turn layered rendering "on" or "off" (default "off").  When "on", the background, grid, axes and labels
+      are cached and only re-rendered when the chart's geometry or grid settings change. */
+  void setLayeredRendering( bool layered );
+
+  /*! Select the rendering backend (default SCENE_BACKEND).  DIRECT_BACKEND paints the chart straight onto the
+      viewport without creating a graphics item per chart item, which is faster for charts with many items. */
+  void setRenderBackend( GobChartsBackend backend );
+
+  /*! Turn progressive rendering "on" or "off" (default "off").  When "on", charts with very many items are built
+      in time slices of "timeSlice" milliseconds behind a coarse preview, keeping the GUI responsive meanwhile. */
+  void setProgressiveRendering( bool progressive, int timeSlice = DEFAULT_TIME_SLICE );
+
+  /*! Sets the quality tier used while the chart is being resized, selected or updated with live data (default
+      FULL_QUALITY, i.e. "off").  Full quality returns after "restoreDelay" idle milliseconds. */
+  void setInteractiveQuality( GobChartsQuality quality, int restoreDelay = DEFAULT_RESTORE_DELAY );
+
+  /*! Turn speculative layouts "on" or "off" (default "off").  When "on", the layouts of the other chart types are
+      calculated in the background so that switching between them with createChart() is immediate.  Cached layouts
+      never take up more than "memoryBudget" bytes in total.
+      \sa speculativeLayoutMemory() */
+  void setSpeculativeLayouts( bool speculative, qint64 memoryBudget = DEFAULT_SPECULATIVE_BUDGET );
+
+  /*! Returns the number of bytes currently taken up by speculative layouts. */
+  qint64 speculativeLayoutMemory() const;
+
+  /*! Turn scrolling mode "on" or "off" (default "off").  When "on", BAR chart bars are never narrower than
+      "minimumBarWidth" and the chart scrolls horizontally instead, creating only the bars that are visible. */
+  void setScrollingMode( bool scrolling, qreal minimumBarWidth = DEFAULT_MIN_BAR_WIDTH );
+
+  /*! Sets the time (in milliseconds) after which a hidden or minimised chart releases its graphics items and
+      caches, keeping only its data (default 0, i.e. "off").  The chart is rebuilt when it is shown again.
+      \sa setHibernationMemoryBudget() and hibernationStats() */
+  void setHibernationTimeout( int milliseconds );
+
+  /*! Sets the (estimated) scene memory all charts in the application may take up together (default 0, i.e. no
+      budget).  Hidden charts are hibernated, least recently shown first, to stay within the budget. */
+  static void setHibernationMemoryBudget( qint64 bytes );
+
+  /*! Returns the current chart's hibernation statistics (number of hibernations and memory reclaimed). */
+  GobChartsHibernationStats hibernationStats() const;
+
+  /*! Zooms BAR and LINE charts into the valid items "firstPosition" to "lastPosition" (zero based, in category order).
+      The mouse wheel zooms as well and Ctrl + drag pans a zoomed chart.
+      \sa resetZoom() */
+  void setZoomRange( int firstPosition, int lastPosition );
+
+  /*! Shows all items again. */
+  void resetZoom();
+
+  /*! Streaming mode (LINE charts only).  Shows a sliding window over the last "windowSize" samples passed to
+      appendStreamSample() instead of the model's data (0 turns streaming "off", the default).  STREAM_STRIP
+      mode renders the samples as a scrolling strip chart, which is cheaper for long, fast windows.  Streamed
+      samples are not kept when the chart type changes.
+      \sa appendStreamSample() */
+  void setStreamingWindow( int windowSize, GobChartsStreamMode mode = STREAM_ITEMS );
+
+  /*! Appends a sample to the streaming window.
+      \sa setStreamingWindow() */
+  void appendStreamSample( qreal value );
+
 signals:
   /*! Emits the last debug log message.
       \sa setDebugLoggingOn() */
   void lastDebugLogMsg( QString );
 
+  /*! Emits the time (in milliseconds) between a keystroke in the chart's header or labels and the repaint showing it. */
+  void labelEditLatency( qreal milliseconds );
+
 private slots:
   void graphicsItemSelected( const QString & legendText );
   void legendItemSelected( QListWidgetItem *item );